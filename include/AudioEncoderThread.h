@@ -0,0 +1,98 @@
+/*
+ * AudioEncoderThread.h - encodes audio into a file on a separate thread
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_AUDIO_ENCODER_THREAD_H
+#define LMMS_AUDIO_ENCODER_THREAD_H
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <vector>
+
+#include "lmms_basics.h"
+#include "PerfLog.h"
+#include "SampleFrame.h"
+
+namespace lmms
+{
+
+class AudioFileDevice;
+
+//! Feeds an AudioFileDevice from its own thread, so that encoding runs in
+//! parallel to rendering. Audio is handed over through a bounded
+//! single-producer/single-consumer ring buffer: write() only copies the frames
+//! and returns, it blocks only when the encoder is a whole ring behind. The
+//! encoder passes everything that has piled up to the device at once, so slow
+//! encoders get few large writes instead of one call per period.
+class AudioEncoderThread : public QThread
+{
+public:
+	static constexpr f_cnt_t DefaultCapacity = 65536;
+
+	//! \p encodeLog receives the time spent inside the device, it may be shared between encoders
+	AudioEncoderThread(AudioFileDevice* device, PerfLogAccumulator* encodeLog = nullptr,
+		f_cnt_t capacity = DefaultCapacity);
+	~AudioEncoderThread() override;
+
+	//! Producer only. Queues the frames for encoding, blocks while the ring is full
+	void write(const SampleFrame* frames, f_cnt_t count);
+
+	//! Producer only. Encodes everything still queued and stops the thread
+	void finish();
+
+	AudioFileDevice* device() const
+	{
+		return m_device;
+	}
+
+private:
+	void run() override;
+
+	f_cnt_t readSpace() const;
+	f_cnt_t writeSpace() const;
+
+	AudioFileDevice* m_device;
+	PerfLogAccumulator* m_encodeLog;
+
+	std::vector<SampleFrame> m_ring;
+	// both indices only ever grow and are taken modulo the ring size
+	alignas(64) std::atomic<f_cnt_t> m_readIndex;
+	alignas(64) std::atomic<f_cnt_t> m_writeIndex;
+
+	std::atomic_bool m_finishing;
+
+	// only used to park the producer or the consumer, never while copying
+	// or encoding - see write() and run() for the wake-up protocol
+	std::atomic_bool m_producerWaiting;
+	std::atomic_bool m_consumerWaiting;
+	QMutex m_waitMutex;
+	QWaitCondition m_spaceAvailable;
+	QWaitCondition m_dataAvailable;
+} ;
+
+} // namespace lmms
+
+#endif // LMMS_AUDIO_ENCODER_THREAD_H
@@ -52,6 +52,8 @@ class AudioEngineWorkerThread;
 
 const fpp_t MINIMUM_BUFFER_SIZE = 32;
 const fpp_t DEFAULT_BUFFER_SIZE = 256;
+// largest period for offline rendering, see AudioEngine::AudioEngine()
+const fpp_t MAXIMUM_RENDER_BUFFER_SIZE = 4096;
 
 const int BYTES_PER_SAMPLE = sizeof( sample_t );
 const int BYTES_PER_INT_SAMPLE = sizeof( int_sample_t );
@@ -171,6 +173,11 @@ public:
 
 
 	// audio-port-stuff
+	const std::vector<AudioPort *>& audioPorts() const
+	{
+		return m_audioPorts;
+	}
+
 	inline void addAudioPort(AudioPort * port)
 	{
 		requestChangeInModel();
@@ -333,7 +340,8 @@ private:
 	} ;
 
 
-	AudioEngine( bool renderOnly );
+	// renderFramesPerPeriod is only used when rendering, 0 selects the default
+	AudioEngine( bool renderOnly, fpp_t renderFramesPerPeriod = 0 );
 	~AudioEngine() override;
 
 	void startProcessing(bool needsFifo = true);
@@ -352,6 +360,8 @@ private:
 
 	void swapBuffers();
 
+	void initMetronome();
+	void cleanupMetronome();
 	void handleMetronome();
 
 	void clearInternal();
@@ -403,6 +413,8 @@ private:
 	AudioEngineProfiler m_profiler;
 
 	bool m_metronomeActive;
+	struct Metronome;
+	std::unique_ptr<Metronome> m_metronome;
 
 	bool m_clearSignal;
 
@@ -70,6 +70,36 @@ public:
 		return m_detailLoad[static_cast<std::size_t>(type)].load(std::memory_order_relaxed);
 	}
 
+	//! Object pools which have to allocate if they run out of preallocated objects
+	enum class PoolType {
+		NotePlayHandles,
+		Count
+	};
+
+	constexpr static auto PoolTypeCount = static_cast<std::size_t>(PoolType::Count);
+
+	//! Thread-safe, may be called from any thread during processing
+	void recordPoolMiss(const PoolType type)
+	{
+		m_poolMisses[static_cast<std::size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::size_t poolMisses(const PoolType type) const
+	{
+		return m_poolMisses[static_cast<std::size_t>(type)].load(std::memory_order_relaxed);
+	}
+
+	//! Length of the longest send chain in the mixer, updated by Mixer whenever its routing changes
+	void setMixerCriticalPath(const int channels)
+	{
+		m_mixerCriticalPath.store(channels, std::memory_order_relaxed);
+	}
+
+	int mixerCriticalPath() const
+	{
+		return m_mixerCriticalPath.load(std::memory_order_relaxed);
+	}
+
 	class Probe
 	{
 	public:
@@ -104,6 +134,10 @@ private:
 	std::array<MicroTimer, DetailCount> m_detailTimer;
 	std::array<int, DetailCount> m_detailTime{0};
 	std::array<std::atomic<float>, DetailCount> m_detailLoad{0};
+
+	std::array<std::atomic<std::size_t>, PoolTypeCount> m_poolMisses{};
+
+	std::atomic_int m_mixerCriticalPath{0};
 };
 
 } // namespace lmms
@@ -25,11 +25,15 @@
 #ifndef LMMS_AUDIO_ENGINE_WORKER_THREAD_H
 #define LMMS_AUDIO_ENGINE_WORKER_THREAD_H
 
+#include <QMutex>
 #include <QThread>
+#include <QWaitCondition>
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
-class QWaitCondition;
+#include "WorkStealingDeque.h"
 
 namespace lmms
 {
@@ -41,6 +45,12 @@ class AudioEngineWorkerThread : public QThread
 {
 	Q_OBJECT
 public:
+	enum class Scheduler
+	{
+		SharedQueue,	// all workers scan one global job array
+		WorkStealing	// per-worker deques, idle workers steal from others
+	} ;
+
 	// internal representation of the job queue - all functions are thread-safe
 	class JobQueue
 	{
@@ -76,21 +86,89 @@ public:
 		OperationMode m_opMode;
 	} ;
 
+	// job queue made of one Chase-Lev deque per worker - jobs are pushed to
+	// the deque of the thread adding them, idle threads steal from the others
+	class StealingJobQueue
+	{
+	public:
+		using OperationMode = JobQueue::OperationMode;
+
+		static constexpr size_t DEQUE_SIZE = JobQueue::JOB_QUEUE_SIZE;
+
+		StealingJobQueue() :
+			m_pending( 0 ),
+			m_opMode( OperationMode::Static ),
+			m_waiting( false )
+		{
+		}
+
+		// must only be called while no worker is processing jobs
+		void init( int numDeques );
+
+		void reset( OperationMode _opMode );
+
+		void addJob( ThreadableJob * _job );
+
+		void run( int _workerIndex );
+		void wait();
+
+	private:
+		using Deque = WorkStealingDeque<ThreadableJob, DEQUE_SIZE>;
+
+		ThreadableJob * nextJob( int _workerIndex );
+		ThreadableJob * steal( int _thief );
+		void jobDone();
+
+		std::vector<std::unique_ptr<Deque>> m_deques;
+		alignas(64) std::atomic_int m_pending;
+		// read by stragglers of the previous round while reset() writes it
+		std::atomic<OperationMode> m_opMode;
+
+		// parked wait of the thread calling wait(), woken by whoever
+		// finishes the last pending job
+		std::atomic_bool m_waiting;
+		QMutex m_waitMutex;
+		QWaitCondition m_allDone;
+	} ;
+
 
 	AudioEngineWorkerThread( AudioEngine* audioEngine );
 	~AudioEngineWorkerThread() override;
 
 	virtual void quit();
 
+	// select the scheduler used by all worker threads - must be called
+	// before any worker thread is created
+	static void setScheduler( Scheduler _scheduler, int _numWorkers );
+
+	static Scheduler scheduler()
+	{
+		return s_scheduler;
+	}
+
 	static void resetJobQueue( JobQueue::OperationMode _opMode =
 													JobQueue::OperationMode::Static )
 	{
-		globalJobQueue.reset( _opMode );
+		if( s_scheduler == Scheduler::WorkStealing )
+		{
+			stealingJobQueue.reset( _opMode );
+		}
+		else
+		{
+			globalJobQueue.reset( _opMode );
+		}
 	}
 
 	static void addJob( ThreadableJob * _job )
 	{
-		globalJobQueue.addJob( _job );
+		if( s_scheduler == Scheduler::WorkStealing )
+		{
+			stealingJobQueue.addJob( _job );
+		}
+		else
+		{
+			globalJobQueue.addJob( _job );
+		}
 	}
 
 	// a convenient helper function allowing to pass a container with pointers
@@ -113,9 +191,14 @@ private:
 	void run() override;
 
 	static JobQueue globalJobQueue;
+	static StealingJobQueue stealingJobQueue;
+	static Scheduler s_scheduler;
 	static QWaitCondition * queueReadyWaitCond;
 	static QList<AudioEngineWorkerThread *> workerThreads;
 
+	// index of this worker's deque in stealingJobQueue, 0 is reserved
+	// for the thread calling startAndWaitForJobs()
+	int m_index;
 	volatile bool m_quit;
 } ;
 
@@ -49,6 +49,13 @@ public:
 
 	OutputSettings const & getOutputSettings() const { return m_outputSettings; }
 
+	// encode audio that does not come from the audio engine's output,
+	// e.g. a single track tapped for stem export
+	void write(const SampleFrame* buffer, const fpp_t frames)
+	{
+		writeBuffer(buffer, frames);
+	}
+
 
 protected:
 	int writeData( const void* data, int len );
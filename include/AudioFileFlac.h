@@ -29,6 +29,7 @@
 
 #include "AudioFileDevice.h"
 #include <sndfile.h>
+#include <vector>
 
 namespace lmms
 {
@@ -65,6 +66,10 @@ private:
 	SF_INFO  m_sfinfo;
 	SNDFILE* m_sf;
 
+	// conversion buffers, kept between calls so that writing does not allocate
+	std::vector<sample_t> m_floatBuffer;
+	std::vector<int_sample_t> m_intBuffer;
+
 	void writeBuffer(const SampleFrame* _ab, fpp_t const frames) override;
 
 	bool startEncoding();
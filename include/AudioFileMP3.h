@@ -30,6 +30,8 @@
 
 #ifdef LMMS_HAVE_MP3LAME
 
+#include <vector>
+
 #include "AudioFileDevice.h"
 
 #include "lame/lame.h"
@@ -67,6 +69,10 @@ private:
 
 private:
 	lame_t m_lame;
+
+	// conversion and output buffers, kept between calls so that writing does not allocate
+	std::vector<float> m_interleavedDataBuffer;
+	std::vector<unsigned char> m_encodingBuffer;
 };
 
 } // namespace lmms
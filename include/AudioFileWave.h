@@ -30,6 +30,7 @@
 #include "AudioFileDevice.h"
 
 #include <sndfile.h>
+#include <vector>
 
 namespace lmms
 {
@@ -64,6 +65,10 @@ private:
 private:
 	SF_INFO m_si;
 	SNDFILE * m_sf;
+
+	// conversion buffers, kept between calls so that writing does not allocate
+	std::vector<float> m_floatBuffer;
+	std::vector<int_sample_t> m_intBuffer;
 } ;
 
 
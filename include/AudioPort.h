@@ -34,6 +34,7 @@
 namespace lmms
 {
 
+class AudioEncoderThread;
 class EffectChain;
 class FloatModel;
 class BoolModel;
@@ -71,6 +72,13 @@ public:
 	void setExtOutputEnabled( bool _enabled );
 
 
+	// whether the buffer holds output for the mixer in the current period
+	bool hasOutput() const
+	{
+		return m_hasOutput;
+	}
+
+
 	// next mixer-channel after this audio-port
 	// (-1 = none  0 = master)
 	inline mix_ch_t nextMixerChannel() const
@@ -96,6 +104,14 @@ public:
 
 	void setName( const QString & _new_name );
 
+	// additionally write the processed output of this port (after effects,
+	// volume and panning but before the mixer) to the given encoder, e.g. for
+	// exporting stems - must only be changed while no buffer is rendered
+	void setTap( AudioEncoderThread * tap )
+	{
+		m_tap = tap;
+	}
+
 
 	bool processEffects();
 
@@ -111,6 +127,7 @@ public:
 
 private:
 	volatile bool m_bufferUsage;
+	bool m_hasOutput;
 
 	SampleFrame* m_portBuffer;
 	QMutex m_portBufferLock;
@@ -129,6 +146,8 @@ private:
 	FloatModel * m_panningModel;
 	BoolModel * m_mutedModel;
 
+	AudioEncoderThread * m_tap;
+
 	friend class AudioEngine;
 	friend class AudioEngineWorkerThread;
 
@@ -53,6 +53,8 @@ public:
 	auto interpolationMode() const -> int { return m_interpolationMode; }
 	auto channels() const -> int { return m_channels; }
 	void setRatio(double ratio);
+	//! Discards the filter history, so the next call to resample() starts on a new signal
+	void reset();
 
 private:
 	int m_interpolationMode = -1;
@@ -29,6 +29,9 @@
 
 #include <QMap>
 #include <QPointer>
+#include <atomic>
+#include <memory>
+#include <vector>
 #if (QT_VERSION >= QT_VERSION_CHECK(5,14,0))
 	#include <QRecursiveMutex>
 #endif
@@ -69,7 +72,7 @@ public:
 
 	AutomationClip( AutomationTrack * _auto_track );
 	AutomationClip( const AutomationClip & _clip_to_copy );
-	~AutomationClip() override = default;
+	~AutomationClip() override;
 
 	bool addObject( AutomatableModel * _obj, bool _search_dup = true );
 
@@ -171,6 +174,15 @@ public:
 	}
 
 	float valueAt( const TimePos & _time ) const;
+	/**
+	 * @brief Evaluates the curve at startTick, startTick + tickStep, ...
+	 *        without locking, e.g. for sample-exact automation
+	 * @param Float first tick, may be fractional
+	 * @param Float distance in ticks between two values
+	 * @param Number of values to write
+	 * @param Output buffer for count values
+	 */
+	void valuesAt(float startTick, float tickStep, std::size_t count, float* out) const;
 	float *valuesAfter( const TimePos & _time ) const;
 
 	QString name() const;
@@ -207,7 +219,27 @@ private:
 	void cleanObjects();
 	void generateTangents();
 	void generateTangents(timeMap::iterator it, int numToGenerate);
-	float valueAt( timeMap::const_iterator v, int offset ) const;
+
+	//! One curve segment from a node to the next one, as a cubic polynomial
+	//! in x = (time - node position) * scale
+	struct CurveSegment
+	{
+		float inValue;
+		float scale;
+		float c0, c1, c2, c3;
+	};
+
+	//! Immutable snapshot of the time map with precomputed segment
+	//! coefficients, so the audio thread never has to touch m_timeMap
+	struct CompiledCurve
+	{
+		std::vector<int> positions;
+		std::vector<CurveSegment> segments;
+	};
+
+	//! Rebuilds the compiled curve from m_timeMap, must be called after every edit
+	void compileCurve();
+	static float valueAt(const CompiledCurve& curve, float time, std::size_t& cursor);
 
 	/**
 	 * @brief
@@ -235,6 +267,14 @@ private:
 	bool m_hasAutomation;
 	ProgressionType m_progressionType;
 
+	// The compiled curve is swapped atomically. Replaced curves are only
+	// deleted once no reader is inside valueAt()/valuesAt() anymore.
+	std::atomic<const CompiledCurve*> m_curve{nullptr};
+	mutable std::atomic_int m_curveReaders{0};
+	std::vector<std::unique_ptr<const CompiledCurve>> m_retiredCurves;
+	// Segment of the last lookup, playback mostly stays in it or moves to the next one
+	mutable std::atomic<std::size_t> m_curveCursor{0};
+
 	bool m_dragging;
 	bool m_dragKeepOutValue; // Should we keep the current dragged node's outValue?
 	float m_dragOutValue; // The outValue of the dragged node's
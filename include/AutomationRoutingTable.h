@@ -0,0 +1,134 @@
+/*
+ * AutomationRoutingTable.h - persistent mapping of automation clips to the
+ *                            models they automate
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_AUTOMATION_ROUTING_TABLE_H
+#define LMMS_AUTOMATION_ROUTING_TABLE_H
+
+#include <QHash>
+#include <QPointer>
+#include <atomic>
+#include <vector>
+
+#include "TimePos.h"
+
+namespace lmms
+{
+
+class AutomatableModel;
+class AutomationClip;
+class Clip;
+class Track;
+
+
+/**
+ * Flattened form of what TrackContainer::automatedValuesFromTracks() finds
+ * on every call: which automation clips (directly or inside pattern clips)
+ * drive which models, in the order in which they override each other.
+ *
+ * The table is only rebuilt after arrangement edits, which call invalidate().
+ * Evaluating it once per tick writes into a flat array and does not allocate.
+ */
+class AutomationRoutingTable
+{
+public:
+	using TrackList = std::vector<Track*>;
+
+	//! Marks all tables as outdated after tracks, clips or their automated
+	//! models changed. Safe to call from any thread.
+	static void invalidate();
+
+	bool isValidFor(int clipNum) const;
+
+	//! Collects the routes of the given tracks, clipNum has the same meaning
+	//! as for TrackContainer::automatedValuesFromTracks()
+	void rebuild(const TrackList& tracks, int clipNum);
+
+	//! Evaluates all routes at the given time
+	void evaluate(TimePos time);
+
+	//! The model's value has been recorded in this tick and must not be overwritten
+	void markRecorded(const AutomatableModel* model);
+
+	//! Applies the values of the last evaluation and moves models that are
+	//! not automated anymore back to their controllers
+	void apply();
+
+	//! Moves all automated models back to their controllers, e.g. when playback stops
+	void release();
+
+	//! Forgets all routes and models
+	void clear();
+
+	//! Automation clips on the automation tracks passed to rebuild(), for recording
+	const std::vector<AutomationClip*>& recordableClips() const
+	{
+		return m_recordableClips;
+	}
+
+	//! Time inside the pattern store for the given time inside a pattern
+	static TimePos patternTime(TimePos time, int patternIndex);
+
+private:
+	struct Route
+	{
+		Track* track;
+		Clip* clip;
+		//! -1 for automation clips, the pattern for pattern clips
+		int patternIndex;
+		//! Automation clips: range in m_routeSlots of the models they automate
+		std::size_t firstSlot;
+		std::size_t numSlots;
+		//! Pattern clips: the routes of the pattern follow up to here
+		std::size_t end;
+	};
+
+	struct Slot
+	{
+		QPointer<AutomatableModel> model;
+		float value;
+		bool automated;
+		bool wasAutomated;
+		bool recorded;
+	};
+
+	void addRoutes(const TrackList& tracks, int clipNum, QHash<AutomatableModel*, std::size_t>& slotIndex);
+	void evaluateRoutes(std::size_t begin, std::size_t end, TimePos time);
+
+	static std::atomic<unsigned> s_revision;
+
+	bool m_valid = false;
+	unsigned m_revision = 0;
+	int m_clipNum = -1;
+
+	std::vector<Route> m_routes;
+	std::vector<std::size_t> m_routeSlots;
+	std::vector<Slot> m_slots;
+	std::vector<AutomationClip*> m_recordableClips;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_AUTOMATION_ROUTING_TABLE_H
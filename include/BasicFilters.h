@@ -36,6 +36,7 @@
 #endif
 
 #include <cmath>
+#include <type_traits>
 
 #include "lmms_basics.h"
 #include "lmms_constants.h"
@@ -44,7 +45,8 @@
 namespace lmms
 {
 
-template<ch_cnt_t CHANNELS=DEFAULT_CHANNELS> class BasicFilters;
+// SUBFILTER is only false for the second stage of the double filter types
+template<ch_cnt_t CHANNELS=DEFAULT_CHANNELS, bool SUBFILTER=true> class BasicFilters;
 
 template<ch_cnt_t CHANNELS>
 class LinkwitzRiley
@@ -183,7 +185,7 @@ private:
 	float m_a1, m_a2, m_b0, m_b1, m_b2;
 	float m_z1 [CHANNELS], m_z2 [CHANNELS];
 	
-	friend class BasicFilters<CHANNELS>; // needed for subfilter stuff in BasicFilters
+	template<ch_cnt_t, bool> friend class BasicFilters; // needed for subfilter stuff in BasicFilters
 };
 using StereoBiQuad = BiQuad<2>;
 
@@ -220,7 +222,7 @@ private:
 };
 using StereoOnePole = OnePole<2>;
 
-template<ch_cnt_t CHANNELS>
+template<ch_cnt_t CHANNELS, bool SUBFILTER>
 class BasicFilters
 {
 public:
@@ -262,7 +264,7 @@ public:
 
 	inline void setFilterType( const FilterType _idx )
 	{
-		m_doubleFilter = _idx == FilterType::DoubleLowPass || _idx == FilterType::DoubleMoog;
+		m_doubleFilter = SUBFILTER && ( _idx == FilterType::DoubleLowPass || _idx == FilterType::DoubleMoog );
 		if( !m_doubleFilter )
 		{
 			m_type = _idx;
@@ -274,29 +276,21 @@ public:
 		m_type = _idx == FilterType::DoubleLowPass 
 			? FilterType::LowPass
 			: FilterType::Moog;
-		if( m_subFilter == nullptr )
+		if constexpr( SUBFILTER )
 		{
-			m_subFilter = new BasicFilters<CHANNELS>(
-						static_cast<sample_rate_t>(
-							m_sampleRate ) );
+			m_subFilter.m_type = static_cast<typename SubFilter::FilterType>( m_type );
 		}
-		m_subFilter->m_type = m_type;
 	}
 
 	inline BasicFilters( const sample_rate_t _sample_rate ) :
 		m_doubleFilter( false ),
 		m_sampleRate( (float) _sample_rate ),
 		m_sampleRatio( 1.0f / m_sampleRate ),
-		m_subFilter( nullptr )
+		m_subFilter( _sample_rate )
 	{
 		clearHistory();
 	}
 
-	inline ~BasicFilters()
-	{
-		delete m_subFilter;
-	}
-
 	inline void clearHistory()
 	{
 		// reset in/out history for biquads
@@ -332,9 +326,9 @@ public:
 	{
 		m_sampleRate = sampleRate;
 		m_sampleRatio = 1.f / m_sampleRate;
-		if (m_subFilter != nullptr)
+		if constexpr (SUBFILTER)
 		{
-			m_subFilter->setSampleRate(m_sampleRate);
+			m_subFilter.setSampleRate(sampleRate);
 		}
 	}
 
@@ -693,9 +687,12 @@ public:
 				break;
 		}
 
-		if( m_doubleFilter )
+		if constexpr( SUBFILTER )
 		{
-			return m_subFilter->update( out, _chnl );
+			if( m_doubleFilter )
+			{
+				return m_subFilter.update( out, _chnl );
+			}
 		}
 
 		// Clipper band limited sigmoid
@@ -775,11 +772,14 @@ public:
 			m_k = 2.0f * m_p - 1;
 			m_r = _q * powf( F_E, ( 1 - m_p ) * 1.386249f );
 
-			if( m_doubleFilter )
+			if constexpr( SUBFILTER )
 			{
-				m_subFilter->m_r = m_r;
-				m_subFilter->m_p = m_p;
-				m_subFilter->m_k = m_k;
+				if( m_doubleFilter )
+				{
+					m_subFilter.m_r = m_r;
+					m_subFilter.m_p = m_p;
+					m_subFilter.m_k = m_k;
+				}
 			}
 			return;
 		}
@@ -862,9 +862,12 @@ public:
 				break;
 		}
 
-		if( m_doubleFilter )
+		if constexpr( SUBFILTER )
 		{
-			m_subFilter->m_biQuad.setCoeffs( m_biQuad.m_a1, m_biQuad.m_a2, m_biQuad.m_b0, m_biQuad.m_b1, m_biQuad.m_b2 );
+			if( m_doubleFilter )
+			{
+				m_subFilter.m_biQuad.setCoeffs( m_biQuad.m_a1, m_biQuad.m_a2, m_biQuad.m_b0, m_biQuad.m_b1, m_biQuad.m_b2 );
+			}
 		}
 	}
 
@@ -907,7 +910,17 @@ private:
 
 	float m_sampleRate;
 	float m_sampleRatio;
-	BasicFilters<CHANNELS> * m_subFilter;
+
+	// the second stage of the double filter types, kept in place so that
+	// switching to them does not allocate
+	struct NoSubFilter
+	{
+		NoSubFilter( sample_rate_t ) {}
+	} ;
+	using SubFilter = std::conditional_t<SUBFILTER, BasicFilters<CHANNELS, false>, NoSubFilter>;
+	SubFilter m_subFilter;
+
+	template<ch_cnt_t, bool> friend class BasicFilters;
 
 } ;
 
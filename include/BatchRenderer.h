@@ -0,0 +1,118 @@
+/*
+ * BatchRenderer.h - renders a list of projects with one engine
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_BATCH_RENDERER_H
+#define LMMS_BATCH_RENDERER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+#include "AudioEngine.h"
+#include "OutputSettings.h"
+#include "ProjectRenderer.h"
+
+namespace lmms
+{
+
+class RenderManager;
+
+//! Renders many projects one after another without restarting LMMS, so the
+//! cost of Engine::init() (wavetables, FFT plans, plugin discovery) is only
+//! paid once. Used by `lmms render --batch <jobs>`.
+class BatchRenderer : public QObject
+{
+	Q_OBJECT
+public:
+	enum class Mode
+	{
+		Project,	//!< one file per project, like `render`
+		Tracks,		//!< one file per track, like `rendertracks`
+		Stems		//!< one file per track in a single pass, like `rendertracks --stems`
+	} ;
+
+	BatchRenderer(const AudioEngine::qualitySettings& qualitySettings,
+		const OutputSettings& outputSettings,
+		ProjectRenderer::ExportFileFormat format,
+		Mode mode,
+		bool exportLoop);
+	~BatchRenderer() override;
+
+	//! Reads one job per line: the project file, optionally followed by a tab
+	//! and the output path. Without an output path, the output is written next
+	//! to the project. Empty lines and lines starting with '#' are skipped.
+	bool loadJobs(const QString& jobFile);
+
+	std::size_t numJobs() const
+	{
+		return m_jobs.size();
+	}
+
+	int failedJobs() const
+	{
+		return m_failedJobs;
+	}
+
+	QStringList projects() const;
+
+public slots:
+	void start();
+
+signals:
+	void finished();
+
+private slots:
+	void renderNextJob();
+	void jobFinished();
+
+private:
+	struct Job
+	{
+		QString project;
+		QString output;
+	} ;
+
+	QString outputPathFor(const Job& job) const;
+
+	const AudioEngine::qualitySettings m_qualitySettings;
+	const OutputSettings m_outputSettings;
+	const ProjectRenderer::ExportFileFormat m_format;
+	const Mode m_mode;
+	const bool m_exportLoop;
+
+	std::vector<Job> m_jobs;
+	std::size_t m_currentJob;
+	int m_failedJobs;
+
+	std::unique_ptr<RenderManager> m_renderManager;
+	QElapsedTimer m_jobTimer;
+	QElapsedTimer m_batchTimer;
+} ;
+
+} // namespace lmms
+
+#endif // LMMS_BATCH_RENDERER_H
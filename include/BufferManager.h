@@ -26,6 +26,8 @@
 #ifndef LMMS_BUFFER_MANAGER_H
 #define LMMS_BUFFER_MANAGER_H
 
+#include <cstddef>
+
 #include "lmms_export.h"
 #include "lmms_basics.h"
 
@@ -34,10 +36,29 @@ namespace lmms
 
 class SampleFrame;
 
+//! Hands out period-sized, cache-line-aligned audio buffers from a pool that
+//! is preallocated in init(). Each thread keeps a few free buffers in a local
+//! cache in front of a lockless global free list, so neither acquire() nor
+//! release() touch the heap or take a lock unless the pool is exhausted.
 class LMMS_EXPORT BufferManager
 {
 public:
+	//! Number of buffers preallocated by init()
+	static constexpr std::size_t PoolSize = 2048;
+
+	struct Stats
+	{
+		std::size_t capacity;		//!< number of preallocated buffers
+		std::size_t inUse;			//!< pool buffers currently handed out
+		std::size_t highWaterMark;	//!< maximum of inUse since the pool was created
+		std::size_t heapFallbacks;	//!< acquire() calls that had to allocate
+	};
+
+	//! (Re)creates the pool if the period size changed. Pools of earlier
+	//! period sizes are freed once all their buffers were released, so this
+	//! must not run while other threads acquire or release buffers.
 	static void init( fpp_t fpp );
+	//! Returns a zeroed buffer of framesPerPeriod frames
 	static SampleFrame* acquire();
 	// audio-buffer-mgm
 	static void clear( SampleFrame* ab, const f_cnt_t frames,
@@ -45,6 +66,8 @@ public:
 
 	static void release( SampleFrame* buf );
 
+	static Stats stats();
+
 private:
 	static fpp_t s_framesPerPeriod;
 };
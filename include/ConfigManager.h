@@ -209,6 +209,12 @@ public:
 		return m_workingDir + "recover.mmp";
 	}
 
+	//! Directory for data that LMMS can regenerate, e.g. plugin scan results
+	const QString & cacheDir() const
+	{
+		return m_cacheDir;
+	}
+
 	inline const QStringList & recentlyOpenedProjects() const
 	{
 		return m_recentlyOpenedProjects;
@@ -296,6 +302,7 @@ private:
 	QString m_themeDir;
 	QString m_backgroundPicFile;
 	QString m_lmmsRcFile;
+	QString m_cacheDir;
 	QString m_version;
 	unsigned int m_configVersion;
 	QStringList m_recentlyOpenedProjects;
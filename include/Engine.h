@@ -52,7 +52,8 @@ class LMMS_EXPORT Engine : public QObject
 {
 	Q_OBJECT
 public:
-	static void init( bool renderOnly );
+	// renderFramesPerPeriod selects the period size when rendering only, 0 for the default
+	static void init( bool renderOnly, fpp_t renderFramesPerPeriod = 0 );
 	static void destroy();
 
 	// core
@@ -29,10 +29,12 @@
 
 #include <ladspa.h>
 
+#include <QFileInfo>
 #include <QMap>
 #include <QPair>
 #include <QString>
 #include <QStringList>
+#include <QVariantList>
 
 
 #include "lmms_export.h"
@@ -74,11 +76,17 @@ enum class LadspaPluginType
 
 struct LadspaManagerDescription
 {
+	//! nullptr until the library in @a file is loaded
 	LADSPA_Descriptor_Function descriptorFunction;
+	QString file;
 	uint32_t index;
 	LadspaPluginType type;
 	uint16_t inputChannels;
 	uint16_t outputChannels;
+	// copied from the descriptor so listing plugins needs no library loaded
+	QString label;
+	QString name;
+	LADSPA_Properties properties;
 };
 
 class LMMS_EXPORT LadspaManager
@@ -330,8 +338,13 @@ public:
 						LADSPA_Handle _instance );
 
 private:
-	void  addPlugins( LADSPA_Descriptor_Function _descriptor_func,
-						const QString & _file );
+	//! Adds all plugins of a loaded library and returns their cache entries
+	QVariantList addPlugins( LADSPA_Descriptor_Function _descriptor_func,
+						const QFileInfo & _file );
+	void  addCachedPlugins( const QVariantList & _plugins,
+						const QFileInfo & _file );
+	void  addPlugin( const ladspa_key_t & _key,
+					LadspaManagerDescription * _description );
 	uint16_t  getPluginInputs( const LADSPA_Descriptor * _descriptor );
 	uint16_t  getPluginOutputs( const LADSPA_Descriptor * _descriptor );
 
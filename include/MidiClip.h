@@ -26,6 +26,8 @@
 #ifndef LMMS_MIDI_CLIP_H
 #define LMMS_MIDI_CLIP_H
 
+#include <utility>
+
 #include "Clip.h"
 #include "Note.h"
 
@@ -76,6 +78,14 @@ public:
 		return m_notes;
 	}
 
+	using NoteRange = std::pair<NoteVector::const_iterator, NoteVector::const_iterator>;
+
+	//! Returns the notes starting exactly at the given position. The position of
+	//! the previous query is remembered, so querying consecutive ticks costs
+	//! amortised O(1) and jumps O(log n). Must be called with the instrument
+	//! track locked, like all other accesses from the audio thread.
+	NoteRange notesStartingAt( const TimePos & pos ) const;
+
 	Note * addStepNote( int step );
 	void setStep( int step, bool enabled );
 
@@ -140,9 +150,12 @@ private:
 	Type m_clipType;
 
 	// data-stuff
-	NoteVector m_notes;
+	NoteVector m_notes;	// always sorted by Note::lessThan
 	int m_steps;
 
+	// index of the first note at or after the position of the last notesStartingAt() query
+	mutable std::size_t m_playCursor = 0;
+
 	MidiClip * adjacentMidiClipByOffset(int offset) const;
 
 	friend class gui::MidiClipView;
@@ -36,6 +36,28 @@ class SampleFrame;
 namespace MixHelpers
 {
 
+//! Instruction sets the mixing functions have been vectorised for
+enum class SimdLevel
+{
+	None,
+	Sse2,
+	Avx2,
+	Avx512,
+	Neon
+};
+
+/*! \brief Instruction set in use, by default the widest one the CPU supports */
+SimdLevel simdLevel();
+
+/*! \brief Whether this build has kernels for the given level and the CPU can run them */
+bool isSimdLevelSupported( SimdLevel level );
+
+/*! \brief Use the kernels of the given level, returns false if it isn't supported */
+bool setSimdLevel( SimdLevel level );
+
+/*! \brief Printable name of the instruction set in use */
+const char* simdLevelName();
+
 bool isSilent( const SampleFrame* src, int frames );
 
 bool useNaNHandler();
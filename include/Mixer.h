@@ -49,7 +49,7 @@ class MixerChannel : public ThreadableJob
 
 		EffectChain m_fxChain;
 
-		// set to true when input fed from mixToChannel or child channel
+		// set to true when input fed from an audio port or child channel
 		bool m_hasInput;
 		// set to true if any effect in the channel is enabled and running
 		bool m_stillRunning;
@@ -62,7 +62,9 @@ class MixerChannel : public ThreadableJob
 		BoolModel m_soloModel;
 		FloatModel m_volumeModel;
 		QString m_name;
-		QMutex m_lock;
+		// output buffers of the audio ports feeding this channel in the
+		// current period, collected by Mixer::masterMix()
+		std::vector<const SampleFrame*> m_inputs;
 		int m_channelIndex; // what channel index are we
 		bool m_queued; // are we queued up for rendering yet?
 		bool m_muted; // are we muted? updated per period so we don't have to call m_muteModel.value() twice
@@ -137,8 +139,6 @@ public:
 	Mixer();
 	~Mixer() override;
 
-	void mixToChannel( const SampleFrame* _buf, mix_ch_t _ch );
-
 	void prepareMasterMix();
 	void masterMix( SampleFrame* _buf );
 
@@ -207,6 +207,13 @@ public:
 		return m_mixerChannels.size();
 	}
 
+	// number of channels on the longest send chain, i.e. the minimum
+	// number of channels that have to be processed one after another
+	int criticalPathLength() const
+	{
+		return m_criticalPathLength;
+	}
+
 	MixerRouteVector m_mixerRoutes;
 
 private:
@@ -216,6 +223,15 @@ private:
 	// make sure we have at least num channels
 	void allocateChannelsTo(int num);
 
+	// recompute m_schedule and the critical path after channels or routes
+	// changed - must be called while the audio engine is locked
+	void rebuildSchedule();
+
+	// all channels in topological order: every channel comes after all
+	// channels sending to it, channels without receives come first
+	std::vector<MixerChannel*> m_schedule;
+	int m_criticalPathLength;
+
 	int m_lastSoloed;
 } ;
 
@@ -26,15 +26,16 @@
 #ifndef LMMS_NOTE_PLAY_HANDLE_H
 #define LMMS_NOTE_PLAY_HANDLE_H
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 #include "BasicFilters.h"
 #include "Note.h"
 #include "PlayHandle.h"
 #include "Track.h"
 
-class QReadWriteLock;
-
 namespace lmms
 {
 
@@ -48,7 +49,8 @@ class LMMS_EXPORT NotePlayHandle : public PlayHandle, public Note
 {
 public:
 	void * m_pluginData;
-	std::unique_ptr<BasicFilters<>> m_filter;
+	//! Created on first use, inside the handle's preallocated pool slot
+	std::optional<BasicFilters<>> m_filter;
 
 	// length of the declicking fade in
 	fpp_t m_fadeInLength;
@@ -334,8 +336,13 @@ private:
 
 
 const int INITIAL_NPH_CACHE = 256;
-const int NPH_CACHE_INCREMENT = 16;
+const int NPH_SEGMENT_SIZE = 256;
+const int MAX_NPH_SEGMENTS = 256;
 
+//! Lock-free pool of NotePlayHandles. Storage is allocated in segments which
+//! are never moved or reallocated, so handles can be acquired and released
+//! from any thread without taking a lock. A new segment is only allocated if
+//! the pool runs dry, which is reported to the AudioEngineProfiler as a pool miss.
 class NotePlayHandleManager
 {
 public:
@@ -348,14 +355,27 @@ public:
 					int midiEventChannel = -1,
 					NotePlayHandle::Origin origin = NotePlayHandle::Origin::MidiClip );
 	static void release( NotePlayHandle * nph );
-	static void extend( int i );
 	static void free();
 
+	//! Total number of handles the pool can currently hold
+	static std::size_t capacity()
+	{
+		return s_segmentCount.load( std::memory_order_relaxed ) * NPH_SEGMENT_SIZE;
+	}
+
 private:
-	static NotePlayHandle ** s_available;
-	static QReadWriteLock s_mutex;
-	static std::atomic_int s_availableIndex;
-	static int s_size;
+	struct Slot;
+	struct Segment;
+
+	static Slot * pop();
+	static void push( Slot * slot );
+	static Slot * slotAt( std::uint32_t index );
+	static Slot * addSegment();
+
+	static std::atomic<Segment*> s_segments[MAX_NPH_SEGMENTS];
+	static std::atomic<std::uint32_t> s_segmentCount;
+	// free list head: ABA tag in the upper, slot index + 1 in the lower half
+	static std::atomic<std::uint64_t> s_freeHead;
 };
 
 
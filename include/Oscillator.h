@@ -266,7 +266,9 @@ private:
 	bool m_isModulator;
 
 	/* Multiband WaveTable */
-	static sample_t s_waveTables[NumWaveShapeTables][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT][OscillatorConstants::WAVETABLE_LENGTH];
+	//! Points to s_waveTableStorage or to the wave table cache file mapped into memory
+	static const sample_t (*s_waveTables)[OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT][OscillatorConstants::WAVETABLE_LENGTH];
+	static sample_t s_waveTableStorage[NumWaveShapeTables][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT][OscillatorConstants::WAVETABLE_LENGTH];
 	static fftwf_plan s_fftPlan;
 	static fftwf_plan s_ifftPlan;
 	static fftwf_complex * s_specBuf;
@@ -277,6 +279,8 @@ private:
 	static void generateSquareWaveTable(int bands, sample_t* table, int firstBand = 1);
 	static void generateFromFFT(int bands, sample_t* table);
 	static void generateWaveTables();
+	static bool loadWaveTables();
+	static void saveWaveTables();
 	static void createFFTPlans();
 
 	/* End Multiband wavetable */
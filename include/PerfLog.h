@@ -25,6 +25,8 @@
 #ifndef LMMS_PERFLOG_H
 #define LMMS_PERFLOG_H
 
+#include <atomic>
+#include <chrono>
 #include <ctime>
 #include <QString>
 
@@ -74,6 +76,34 @@ class PerfLogTimer
 	PerfTime begin_time;
 };
 
+/// \brief Sums up the wall-clock time of many short intervals
+///
+/// Intended for work that is spread over a whole operation, like the time
+/// spent encoding during an export. Intervals may be added from any thread.
+/// The total is printed to stderr on destruction or when calling end().
+class PerfLogAccumulator
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	PerfLogAccumulator(const QString& name);
+	~PerfLogAccumulator();
+
+	void add(Clock::duration interval)
+	{
+		m_total.fetch_add(interval.count(), std::memory_order_relaxed);
+		m_intervals.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void end();
+
+private:
+	QString m_name;
+	std::atomic<Clock::rep> m_total;
+	std::atomic<long> m_intervals;
+	bool m_ended;
+};
+
 
 } // namespace lmms
 
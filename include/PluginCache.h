@@ -0,0 +1,95 @@
+/*
+ * PluginCache.h - on-disk cache of plugin scan results
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_PLUGIN_CACHE_H
+#define LMMS_PLUGIN_CACHE_H
+
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVariantMap>
+
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+
+/// \brief Remembers what scanning a plugin library found out
+///
+/// Entries are keyed by the absolute path of a library and are only returned
+/// as long as its size and modification time (and that of the data files
+/// passed along) are unchanged, so that unchanged
+/// libraries need not be loaded during startup. The cache is stored in
+/// ConfigManager::cacheDir() when the object is destroyed. Entries which were
+/// neither looked up nor inserted are dropped then, which forgets about
+/// removed libraries.
+class LMMS_EXPORT PluginCache
+{
+public:
+	/// @param name File name of the cache, one per plugin manager
+	/// @param context Anything besides the libraries that affects the scan
+	///   results. A cache stored with a different context is discarded.
+	PluginCache(const QString& name, const QString& context = QString());
+	~PluginCache();
+
+	PluginCache(const PluginCache&) = delete;
+	PluginCache& operator=(const PluginCache&) = delete;
+
+	/// Sets @p data to the entry for @p file and returns true if it is valid
+	/// @param dataModified Newest modification time (ms since epoch) of other
+	///   files the scan result depends on, e.g. the data files of an LV2 bundle
+	bool lookup(const QFileInfo& file, QVariantMap& data, qint64 dataModified = 0);
+	void insert(const QFileInfo& file, const QVariantMap& data, qint64 dataModified = 0);
+
+	/// Makes all caches start out empty, e.g. for the --rescan-plugins option
+	static void setRescan(bool rescan) { s_rescan = rescan; }
+	static bool rescan() { return s_rescan; }
+
+private:
+	struct Entry
+	{
+		qint64 size;
+		qint64 modified;
+		QVariantMap data;
+	};
+
+	void load();
+	void save() const;
+
+	QString m_fileName;
+	QString m_context;
+	QHash<QString, Entry> m_entries;
+	QSet<QString> m_used;
+	bool m_modified = false;
+
+	static bool s_rescan;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_PLUGIN_CACHE_H
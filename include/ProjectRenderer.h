@@ -25,6 +25,9 @@
 #ifndef LMMS_PROJECT_RENDERER_H
 #define LMMS_PROJECT_RENDERER_H
 
+#include <memory>
+#include <vector>
+
 #include "AudioFileDevice.h"
 #include "lmmsconfig.h"
 #include "AudioEngine.h"
@@ -35,6 +38,9 @@
 namespace lmms
 {
 
+class AudioEncoderThread;
+class AudioPort;
+
 
 class LMMS_EXPORT ProjectRenderer : public QThread
 {
@@ -65,13 +71,17 @@ public:
 				const OutputSettings & _os,
 				ExportFileFormat _file_format,
 				const QString & _out_file );
-	~ProjectRenderer() override = default;
+	~ProjectRenderer() override;
 
 	bool isReady() const
 	{
 		return m_fileDev != nullptr;
 	}
 
+	// additionally encode the output of the given audio port into its own
+	// file while rendering, returns false if the file could not be created
+	bool addStem( AudioPort * port, const QString & outputFilename );
+
 	static ExportFileFormat getFileFormatFromExtension(
 							const QString & _ext );
 
@@ -91,9 +101,21 @@ signals:
 
 
 private:
+	struct Stem
+	{
+		AudioPort * port;
+		std::unique_ptr<AudioFileDevice> device;
+		std::unique_ptr<AudioEncoderThread> encoder;
+	} ;
+
+	AudioFileDevice * createFileDevice( const QString & outputFilename ) const;
+
 	void run() override;
 
 	AudioFileDevice * m_fileDev;
+	std::vector<Stem> m_stems;
+	OutputSettings m_outputSettings;
+	ExportFileFormat m_fileFormat;
 	AudioEngine::qualitySettings m_qualitySettings;
 
 	volatile int m_progress;
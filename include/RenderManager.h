@@ -54,8 +54,20 @@ public:
 	/// Export all unmuted tracks into individual file
 	void renderTracks();
 
+	/// Export all unmuted tracks into individual files in a single pass of
+	/// the song. Each file is taken from the track's output after its own
+	/// effects, i.e. without mixer effects. The master output is exported as well.
+	void renderStems();
+
 	void abortProcessing();
 
+	/// Number of output files that could not be written, e.g. because
+	/// their file device failed to open
+	int failedRenders() const
+	{
+		return m_failedRenders;
+	}
+
 signals:
 	void progressChanged( int );
 	void finished();
@@ -68,7 +80,10 @@ private:
 	QString pathForTrack( const Track *track, int num );
 	void restoreMutedState();
 
-	void render( QString outputPath );
+	// all unmuted instrument and sample tracks of the song and the pattern store
+	static std::vector<Track*> renderableTracks();
+
+	void render( QString outputPath, const std::vector<Track*>& stems = {} );
 
 	const AudioEngine::qualitySettings m_qualitySettings;
 	const AudioEngine::qualitySettings m_oldQualitySettings;
@@ -80,6 +95,8 @@ private:
 
 	std::vector<Track*> m_tracksToRender;
 	std::vector<Track*> m_unmuted;
+
+	int m_failedRenders;
 } ;
 
 
@@ -31,6 +31,7 @@
 #include "AudioResampler.h"
 #include "Note.h"
 #include "SampleBuffer.h"
+#include "SampleStream.h"
 #include "lmms_export.h"
 
 namespace lmms {
@@ -68,11 +69,20 @@ public:
 		void setVaryingPitch(bool varyingPitch) { m_varyingPitch = varyingPitch; }
 		void setBackwards(bool backwards) { m_backwards = backwards; }
 
+		//! Rewinds to the start without reallocating the resampler
+		void reset()
+		{
+			m_resampler.reset();
+			m_frameIndex = 0;
+			m_backwards = false;
+		}
+
 	private:
 		AudioResampler m_resampler;
 		int m_frameIndex = 0;
 		bool m_varyingPitch = false;
 		bool m_backwards = false;
+		bool m_resampling = false; //!< whether the previous play() call went through the resampler
 		friend class Sample;
 	};
 
@@ -117,7 +127,9 @@ public:
 	void setReversed(bool reversed) { m_reversed.store(reversed, std::memory_order_relaxed); }
 
 private:
-	void playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const;
+	//! Copies up to numFrames frames without resampling and returns the number of frames written
+	auto playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const -> size_t;
+	auto playStreamed(SampleFrame* dst, size_t numFrames, const PlaybackState* state) const -> size_t;
 	void advance(PlaybackState* state, size_t advanceAmount, Loop loopMode) const;
 
 private:
@@ -129,6 +141,7 @@ private:
 	std::atomic<float> m_amplification = 1.0f;
 	std::atomic<float> m_frequency = DefaultBaseFreq;
 	std::atomic<bool> m_reversed = false;
+	std::shared_ptr<SampleStream> m_stream; //!< only for streamed buffers, each copy reads the file on its own
 };
 } // namespace lmms
 #endif
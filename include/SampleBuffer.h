@@ -27,6 +27,8 @@
 
 #include <QByteArray>
 #include <QString>
+#include <cassert>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <samplerate.h>
@@ -44,15 +46,26 @@ public:
 	using value_type = SampleFrame;
 	using reference = SampleFrame&;
 	using const_reference = const SampleFrame&;
-	using iterator = std::vector<SampleFrame>::iterator;
-	using const_iterator = std::vector<SampleFrame>::const_iterator;
-	using difference_type = std::vector<SampleFrame>::difference_type;
-	using size_type = std::vector<SampleFrame>::size_type;
-	using reverse_iterator = std::vector<SampleFrame>::reverse_iterator;
-	using const_reverse_iterator = std::vector<SampleFrame>::const_reverse_iterator;
+	using iterator = SampleFrame*;
+	using const_iterator = const SampleFrame*;
+	using difference_type = std::ptrdiff_t;
+	using size_type = std::size_t;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	//! A file which is read from disk while playing instead of being decoded into memory, see SampleStream
+	struct StreamInfo
+	{
+		size_type frames;
+		std::vector<SampleFrame> reversedHead; //!< the last frames of the file, last frame first
+		std::vector<SampleFrame> overview; //!< the maximum and minimum of every OverviewBlockFrames frames
+	};
+
+	static constexpr auto OverviewBlockFrames = size_type{256};
 
 	SampleBuffer() = default;
 	explicit SampleBuffer(const QString& audioFile);
+	SampleBuffer(const QString& audioFile, std::vector<SampleFrame> head, StreamInfo streamInfo, int sampleRate);
 	SampleBuffer(const QString& base64, int sampleRate);
 	SampleBuffer(std::vector<SampleFrame> data, int sampleRate);
 	SampleBuffer(
@@ -64,32 +77,54 @@ public:
 	auto audioFile() const -> const QString& { return m_audioFile; }
 	auto sampleRate() const -> sample_rate_t { return m_sampleRate; }
 
-	auto begin() -> iterator { return m_data.begin(); }
-	auto end() -> iterator { return m_data.end(); }
+	//! Streamed buffers cannot be iterated, as only their head() is held in memory
+	auto begin() -> iterator { assert(!streamed()); return frames(); }
+	auto end() -> iterator { assert(!streamed()); return frames() + size(); }
 
-	auto begin() const -> const_iterator { return m_data.begin(); }
-	auto end() const -> const_iterator { return m_data.end(); }
+	auto begin() const -> const_iterator { assert(!streamed()); return data(); }
+	auto end() const -> const_iterator { assert(!streamed()); return data() + size(); }
 
-	auto cbegin() const -> const_iterator { return m_data.cbegin(); }
-	auto cend() const -> const_iterator { return m_data.cend(); }
+	auto cbegin() const -> const_iterator { return begin(); }
+	auto cend() const -> const_iterator { return end(); }
 
-	auto rbegin() -> reverse_iterator { return m_data.rbegin(); }
-	auto rend() -> reverse_iterator { return m_data.rend(); }
+	auto rbegin() -> reverse_iterator { return reverse_iterator{end()}; }
+	auto rend() -> reverse_iterator { return reverse_iterator{begin()}; }
 
-	auto rbegin() const -> const_reverse_iterator { return m_data.rbegin(); }
-	auto rend() const -> const_reverse_iterator { return m_data.rend(); }
+	auto rbegin() const -> const_reverse_iterator { return const_reverse_iterator{end()}; }
+	auto rend() const -> const_reverse_iterator { return const_reverse_iterator{begin()}; }
 
-	auto crbegin() const -> const_reverse_iterator { return m_data.crbegin(); }
-	auto crend() const -> const_reverse_iterator { return m_data.crend(); }
+	auto crbegin() const -> const_reverse_iterator { return rbegin(); }
+	auto crend() const -> const_reverse_iterator { return rend(); }
 
-	auto data() const -> const SampleFrame* { return m_data.data(); }
-	auto size() const -> size_type { return m_data.size(); }
-	auto empty() const -> bool { return m_data.empty(); }
+	//! For streamed buffers, only the first head().size() frames are held in memory
+	auto data() const -> const SampleFrame* { return m_mapped ? m_mapped.get() : m_data.data(); }
+	auto size() const -> size_type
+	{
+		return m_streamInfo ? m_streamInfo->frames : m_mapped ? m_mappedFrames : m_data.size();
+	}
+	auto empty() const -> bool { return size() == 0; }
+
+	auto streamed() const -> bool { return m_streamInfo.has_value(); }
+	//! The frames of a streamed buffer which are kept in memory, in playback order
+	auto head(bool reversed = false) const -> const std::vector<SampleFrame>&
+	{
+		return reversed && m_streamInfo ? m_streamInfo->reversedHead : m_data;
+	}
+	//! Peaks of a streamed buffer for drawing its waveform, empty for other buffers
+	auto overview() const -> const std::vector<SampleFrame>& { return m_streamInfo ? m_streamInfo->overview : s_noFrames; }
 
 	static auto emptyBuffer() -> std::shared_ptr<const SampleBuffer>;
 
 private:
+	auto frames() -> SampleFrame* { return m_mapped ? m_mapped.get() : m_data.data(); }
+
+	static inline const auto s_noFrames = std::vector<SampleFrame>{};
+
 	std::vector<SampleFrame> m_data;
+	//! Frames mapped from SampleDiskCache instead of m_data, the mapping is private and may be written to
+	std::shared_ptr<SampleFrame> m_mapped;
+	size_type m_mappedFrames = 0;
+	std::optional<StreamInfo> m_streamInfo;
 	QString m_audioFile;
 	sample_rate_t m_sampleRate = Engine::audioEngine()->outputSampleRate();
 };
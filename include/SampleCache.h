@@ -0,0 +1,107 @@
+/*
+ * SampleCache.h - process-wide cache of decoded audio files
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_SAMPLE_CACHE_H
+#define LMMS_SAMPLE_CACHE_H
+
+#include <QHash>
+#include <QString>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "SampleBuffer.h"
+#include "lmms_export.h"
+
+namespace lmms {
+class PerfLogAccumulator;
+
+//! Shares decoded audio files between everything that loads them, so a file used by many tracks or instruments is
+//! only decoded and held in memory once. Entries are keyed by absolute path and are dropped when the file's size
+//! or modification time changes. Buffers stay cached as long as anyone uses them; unused buffers are additionally
+//! kept alive up to a byte budget, in least recently used order.
+class LMMS_EXPORT SampleCache
+{
+public:
+	static constexpr auto DefaultByteBudget = std::size_t{256} * 1024 * 1024;
+
+	//! Returns the decoded contents of @p audioFile. Throws std::runtime_error like SampleBuffer(const QString&).
+	static auto get(const QString& audioFile) -> std::shared_ptr<const SampleBuffer>;
+	//! Like get(), but files too long to be kept in memory are returned as streamed buffers, see SampleStream
+	static auto getStreamed(const QString& audioFile) -> std::shared_ptr<const SampleBuffer>;
+
+	//! Starts loading @p audioFile on the thread pool, so a later get() or getStreamed() only has to wait for it.
+	//! The future holds nullptr if loading failed, the error is thrown by the later call instead.
+	static auto prefetch(const QString& audioFile, bool streamed = false, PerfLogAccumulator* log = nullptr)
+		-> std::shared_future<std::shared_ptr<const SampleBuffer>>;
+
+	//! Limits how many bytes of otherwise unused buffers are kept
+	static void setByteBudget(std::size_t bytes);
+	static void clear();
+
+private:
+	struct FileInfo
+	{
+		FileInfo(const QString& audioFile, bool streamed);
+
+		QString path;
+		QString key; //!< streamed and decoded buffers of the same file are cached separately
+		qint64 size;
+		qint64 modified;
+	};
+
+	struct Recent
+	{
+		QString key;
+		std::shared_ptr<const SampleBuffer> buffer;
+	};
+
+	struct Entry
+	{
+		qint64 size;
+		qint64 modified;
+		std::weak_ptr<const SampleBuffer> buffer;
+		std::list<Recent>::iterator recent; //!< position in s_recent, or its end
+	};
+
+	static auto fetch(const QString& audioFile, bool streamed) -> std::shared_ptr<const SampleBuffer>;
+	static auto load(const QString& audioFile, bool streamed) -> std::shared_ptr<const SampleBuffer>;
+	//! Returns the cached buffer for @p file if it is still up to date, the caller must hold s_mutex
+	static auto lookup(const FileInfo& file) -> std::shared_ptr<const SampleBuffer>;
+	static void touch(const QString& key, Entry& entry, std::shared_ptr<const SampleBuffer> buffer);
+	static void trim();
+
+	static inline std::mutex s_mutex;
+	static inline QHash<QString, Entry> s_entries;
+	static inline QHash<QString, std::shared_future<std::shared_ptr<const SampleBuffer>>> s_pending;
+	//! Strong references to the most recently used buffers, most recent first
+	static inline std::list<Recent> s_recent;
+	static inline std::size_t s_recentBytes = 0;
+	static inline std::size_t s_byteBudget = DefaultByteBudget;
+};
+} // namespace lmms
+
+#endif // LMMS_SAMPLE_CACHE_H
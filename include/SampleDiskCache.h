@@ -0,0 +1,63 @@
+/*
+ * SampleDiskCache.h - decoded audio files kept on disk for mapping
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_SAMPLE_DISK_CACHE_H
+#define LMMS_SAMPLE_DISK_CACHE_H
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "SampleFrame.h"
+
+namespace lmms {
+//! Keeps the decoded frames of compressed audio files in the cache directory, keyed by a hash of the file's
+//! contents. Loading a file again maps its cached frames instead of decoding it, and since the mapping is only
+//! written to privately, its pages are shared by all LMMS processes using the same file.
+class SampleDiskCache
+{
+public:
+	struct Mapping
+	{
+		std::shared_ptr<SampleFrame> data; //!< keeps the mapped file open
+		std::size_t frames;
+		int sampleRate;
+	};
+
+	//! The least recently used entries are removed when the cache grows beyond this
+	static constexpr auto ByteBudget = std::int64_t{2} * 1024 * 1024 * 1024;
+
+	//! Returns the key of @p audioFile, or an empty key if it should not be cached
+	static auto key(const QString& audioFile) -> QByteArray;
+
+	static auto load(const QByteArray& key) -> std::optional<Mapping>;
+	static void store(const QByteArray& key, const std::vector<SampleFrame>& data, int sampleRate);
+};
+} // namespace lmms
+
+#endif // LMMS_SAMPLE_DISK_CACHE_H
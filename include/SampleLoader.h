@@ -38,6 +38,8 @@ public:
 	static QString openAudioFile(const QString& previousFile = "");
 	static QString openWaveformFile(const QString& previousFile = "");
 	static std::shared_ptr<const SampleBuffer> createBufferFromFile(const QString& filePath);
+	//! Like createBufferFromFile, but long files are streamed from disk while playing instead
+	static std::shared_ptr<const SampleBuffer> createStreamedBufferFromFile(const QString& filePath);
 	static std::shared_ptr<const SampleBuffer> createBufferFromBase64(
 		const QString& base64, int sampleRate = Engine::audioEngine()->outputSampleRate());
 private:
@@ -80,6 +80,10 @@ public:
 		m_volumeModel = _model;
 	}
 
+	// play the given sample from its start again - only for handles
+	// which do not own their sample
+	void restart( Sample* sample );
+
 
 private:
 	Sample* m_sample;
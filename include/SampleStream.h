@@ -0,0 +1,113 @@
+/*
+ * SampleStream.h - reads long audio files from disk while they play
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_SAMPLE_STREAM_H
+#define LMMS_SAMPLE_STREAM_H
+
+#include <QFile>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "SampleBuffer.h"
+#include "lmms_export.h"
+
+struct SNDFILE_tag;
+
+namespace lmms {
+//! Plays a streamed SampleBuffer without holding the file in memory. A shared I/O thread reads ahead of the
+//! playback position into a ring buffer, while the start of the file is served from the buffer's head, so
+//! playback from the start does not have to wait for the disk. Each stream is meant for a single reader, e.g.
+//! the Sample of one clip. The I/O thread keeps a stream alive while it reads into it, so the last reference may
+//! be dropped on any thread.
+class LMMS_EXPORT SampleStream
+{
+public:
+	//! Files whose decoded data would be larger than this are streamed
+	static constexpr auto ThresholdBytes = std::size_t{64} * 1024 * 1024;
+	static constexpr auto HeadFrames = std::size_t{65536};
+	static constexpr auto RingFrames = std::size_t{131072};
+	static constexpr auto ChunkFrames = std::size_t{8192};
+
+	//! Returns a streamed buffer for @p audioFile, or nullptr if it is too short or cannot be streamed
+	static auto createBuffer(const QString& audioFile) -> std::shared_ptr<const SampleBuffer>;
+
+	//! Creates a stream for the streamed @p buffer and hands it to the I/O thread
+	static auto create(std::shared_ptr<const SampleBuffer> buffer) -> std::shared_ptr<SampleStream>;
+	~SampleStream();
+
+	SampleStream(const SampleStream&) = delete;
+	SampleStream(SampleStream&&) = delete;
+	auto operator=(const SampleStream&) -> SampleStream& = delete;
+	auto operator=(SampleStream&&) -> SampleStream& = delete;
+
+	//! Copies @p frames frames starting at @p position, counted from the end of the file if @p reversed is set.
+	//! Reading backwards or far ahead of the last call makes the I/O thread restart at @p position.
+	//! Without @p wait, this is realtime safe and frames which have not been read from disk yet are zeroed.
+	//! With @p wait, it blocks until the I/O thread has read them, for rendering faster than realtime.
+	void read(SampleFrame* dst, std::size_t position, std::size_t frames, bool reversed, bool wait = false);
+
+private:
+	explicit SampleStream(std::shared_ptr<const SampleBuffer> buffer);
+
+	void restart(std::size_t position, bool reversed);
+	//! Blocks until the ring holds the frames of the current epoch up to @p end
+	void waitFor(std::size_t end);
+	//! Called on the I/O thread. Reads at most one chunk and returns whether there was anything to read.
+	auto fill() -> bool;
+	auto readFile(std::size_t filePosition, std::size_t frames) -> std::size_t;
+
+	static void run();
+
+	std::shared_ptr<const SampleBuffer> m_buffer;
+	QFile m_file;
+	SNDFILE_tag* m_sndFile = nullptr;
+	int m_channels = 0;
+
+	std::vector<SampleFrame> m_ring;
+	std::vector<float> m_chunk;
+
+	// written by the reader
+	std::atomic<unsigned> m_requestedEpoch = 0;
+	std::atomic<std::size_t> m_requestedPosition = 0;
+	std::atomic<bool> m_requestedReversed = false;
+	std::atomic<std::size_t> m_consumed = 0; //!< no frame before this is read again in the current epoch
+
+	// written by the I/O thread
+	std::atomic<unsigned> m_readyEpoch = 0;
+	std::atomic<std::size_t> m_end = 0; //!< the ring holds the frames from m_consumed up to here
+
+	// reader side state
+	unsigned m_epoch = 0;
+	bool m_reversed = false;
+
+	// I/O thread side state
+	unsigned m_servedEpoch = 0;
+	bool m_servedReversed = false;
+	std::size_t m_filePosition = 0;
+};
+} // namespace lmms
+
+#endif // LMMS_SAMPLE_STREAM_H
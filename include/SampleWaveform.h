@@ -42,6 +42,10 @@ public:
 		bool reversed;
 	};
 
+	//! Parameters for drawing the whole of @p sample. Streamed samples only keep their head in memory and are
+	//! drawn from their overview, which spans the same time.
+	static auto parameters(const Sample& sample) -> Parameters;
+
 	static void visualize(Parameters parameters, QPainter& painter, const QRect& rect);
 };
 } // namespace lmms::gui
@@ -32,6 +32,7 @@
 #include <QString>
 
 #include "AudioEngine.h"
+#include "AutomationRoutingTable.h"
 #include "Controller.h"
 #include "lmms_constants.h"
 #include "MeterModel.h"
@@ -511,7 +512,7 @@ private:
 	std::shared_ptr<Scale> m_scales[MaxScaleCount];
 	std::shared_ptr<Keymap> m_keymaps[MaxKeymapCount];
 
-	AutomatedValueMap m_oldAutomatedValues;
+	AutomationRoutingTable m_automationRouting;
 
 	friend class Engine;
 	friend class gui::SongEditor;
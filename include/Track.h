@@ -25,6 +25,7 @@
 #ifndef LMMS_TRACK_H
 #define LMMS_TRACK_H
 
+#include <memory>
 #include <vector>
 
 #include <QColor>
@@ -123,6 +124,8 @@ public:
 	// -- for usage by Clip only ---------------
 	Clip * addClip( Clip * clip );
 	void removeClip( Clip * clip );
+	//! Called whenever the position or length of one of our clips changed
+	void clipBoundsChanged();
 	// -------------------------------------------------------
 	void deleteClips();
 
@@ -226,6 +229,12 @@ private:
 
 	clipVector m_clips;
 
+	class ClipIndex;
+
+	// index for getClipsInRange(), rebuilt whenever our clips change and
+	// swapped in with std::atomic_store, so the audio thread never waits
+	std::shared_ptr<const ClipIndex> m_clipIndex;
+
 	QMutex m_processingLock;
 	
 	std::optional<QColor> m_color;
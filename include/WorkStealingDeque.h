@@ -0,0 +1,131 @@
+/*
+ * WorkStealingDeque.h - fixed-size Chase-Lev work-stealing deque
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_WORK_STEALING_DEQUE_H
+#define LMMS_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace lmms
+{
+
+//! Single-owner, multi-thief deque of pointers (Chase & Lev, "Dynamic circular work-stealing deque",
+//! with the memory orderings of Lê et al., PPoPP 2013). The owner pushes and pops at the bottom,
+//! any other thread may steal from the top. The capacity is fixed so that no allocation happens
+//! while the audio engine is processing - push() fails instead of growing the buffer.
+template<typename T, std::size_t Capacity>
+class WorkStealingDeque
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	WorkStealingDeque() :
+		m_top(0),
+		m_bottom(0)
+	{
+		for (auto& item : m_items)
+		{
+			item.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	//! Owner only
+	bool push(T* item)
+	{
+		const auto b = m_bottom.load(std::memory_order_relaxed);
+		const auto t = m_top.load(std::memory_order_acquire);
+		if (b - t >= static_cast<std::int64_t>(Capacity)) { return false; }
+
+		m_items[b & Mask].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	//! Owner only, returns nullptr if the deque is empty
+	T* pop()
+	{
+		const auto b = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto t = m_top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			// empty
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T* item = m_items[b & Mask].load(std::memory_order_relaxed);
+		if (t == b)
+		{
+			// last item - race against thieves for it
+			if (!m_top.compare_exchange_strong(t, t + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				item = nullptr;
+			}
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	//! Any thread, returns nullptr if the deque is empty or the steal lost a race
+	T* steal()
+	{
+		auto t = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const auto b = m_bottom.load(std::memory_order_acquire);
+
+		if (t >= b) { return nullptr; }
+
+		T* item = m_items[t & Mask].load(std::memory_order_relaxed);
+		if (!m_top.compare_exchange_strong(t, t + 1,
+			std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+		return item;
+	}
+
+	bool empty() const
+	{
+		return m_bottom.load(std::memory_order_acquire) <= m_top.load(std::memory_order_acquire);
+	}
+
+private:
+	static constexpr std::size_t Mask = Capacity - 1;
+
+	// top is written by thieves, bottom by the owner - keep them on separate cache lines
+	alignas(64) std::atomic<std::int64_t> m_top;
+	alignas(64) std::atomic<std::int64_t> m_bottom;
+	alignas(64) std::atomic<T*> m_items[Capacity];
+};
+
+} // namespace lmms
+
+#endif // LMMS_WORK_STEALING_DEQUE_H
@@ -106,6 +106,17 @@ int LMMS_EXPORT compressbands(const float * _absspec_buffer, float * _compressed
 			int _num_old, int _num_new, int _bottom, int _top);
 
 
+/**	Import the FFTW wisdom saved by an earlier run, so that plans created with
+ *	FFTW_MEASURE do not need to be measured again. Call before creating plans.
+ */
+void LMMS_EXPORT loadFftwWisdom();
+
+
+/**	Save the FFTW wisdom gathered so far, if it has changed since loading.
+ */
+void LMMS_EXPORT saveFftwWisdom();
+
+
 } // namespace lmms
 
 #endif // LMMS_FFT_HELPERS_H
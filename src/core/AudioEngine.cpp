@@ -24,6 +24,9 @@
 
 #include "AudioEngine.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "MixHelpers.h"
 #include "denormals.h"
 
@@ -64,6 +67,44 @@
 namespace lmms
 {
 
+// The clicks are decoded once and played through one persistent handle and
+// port, so the metronome neither reads files nor allocates while rendering
+struct AudioEngine::Metronome
+{
+	static Sample loadClick( const QString & file )
+	{
+		try
+		{
+			return Sample( file );
+		}
+		catch( const std::runtime_error & )
+		{
+			return Sample();
+		}
+	}
+
+	Metronome() :
+		barClick( loadClick( "misc/metronome02.ogg" ) ),
+		beatClick( loadClick( "misc/metronome01.ogg" ) ),
+		port( "Metronome", false ),
+		handle( &beatClick, false )
+	{
+		handle.setAudioPort( &port );
+		port.addPlayHandle( &handle );
+	}
+
+	~Metronome()
+	{
+		port.removePlayHandle( &handle );
+	}
+
+	Sample barClick;
+	Sample beatClick;
+	AudioPort port;
+	SamplePlayHandle handle;
+	bool playing = false;
+};
+
 using LocklessListElement = LocklessList<PlayHandle*>::Element;
 
 static thread_local bool s_renderingThread = false;
@@ -71,7 +112,7 @@ static thread_local bool s_renderingThread = false;
 
 
 
-AudioEngine::AudioEngine( bool renderOnly ) :
+AudioEngine::AudioEngine( bool renderOnly, fpp_t renderFramesPerPeriod ) :
 	m_renderOnly( renderOnly ),
 	m_framesPerPeriod( DEFAULT_BUFFER_SIZE ),
 	m_inputBufferRead( 0 ),
@@ -128,6 +169,17 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 			m_framesPerPeriod = DEFAULT_BUFFER_SIZE;
 		}
 	}
+	// when rendering offline, larger periods may be requested to cut the
+	// per-period overhead (job queues, mixer graph, LFOs). Notes still start
+	// at their exact frame as Song::processNextBuffer() splits each period at
+	// tick boundaries. Instruments and effects only see the automated and
+	// controlled values of the end of each period though, so main.cpp only
+	// requests larger periods for projects without automation or controllers.
+	else if( renderFramesPerPeriod > 0 )
+	{
+		m_framesPerPeriod = std::clamp( renderFramesPerPeriod,
+						MINIMUM_BUFFER_SIZE, MAXIMUM_RENDER_BUFFER_SIZE );
+	}
 
 	// allocte the FIFO from the determined size
 	m_fifo = new Fifo( fifoSize );
@@ -138,6 +190,11 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	m_outputBufferRead = std::make_unique<SampleFrame[]>(m_framesPerPeriod);
 	m_outputBufferWrite = std::make_unique<SampleFrame[]>(m_framesPerPeriod);
 
+	const bool workStealing =
+		ConfigManager::inst()->value( "audioengine", "jobscheduler" ) == "workstealing";
+	AudioEngineWorkerThread::setScheduler( workStealing
+		? AudioEngineWorkerThread::Scheduler::WorkStealing
+		: AudioEngineWorkerThread::Scheduler::SharedQueue, m_numWorkers );
 
 	for( int i = 0; i < m_numWorkers+1; ++i )
 	{
@@ -346,6 +403,12 @@ void AudioEngine::renderStageNoteSetup()
 	mixer->prepareMasterMix();
 
 	handleMetronome();
+	if (m_metronome && m_metronome->playing)
+	{
+		// fills the handle's buffer, which the metronome port mixes in stage 2
+		m_metronome->handle.doProcessing();
+		m_metronome->playing = !m_metronome->handle.isFinished();
+	}
 
 	// create play-handles for new notes, samples etc.
 	Engine::getSong()->processNextBuffer();
@@ -462,6 +525,22 @@ void AudioEngine::swapBuffers()
 
 
 
+void AudioEngine::initMetronome()
+{
+	m_metronome = std::make_unique<Metronome>();
+}
+
+
+
+
+void AudioEngine::cleanupMetronome()
+{
+	m_metronome.reset();
+}
+
+
+
+
 void AudioEngine::handleMetronome()
 {
 	static tick_t lastMetroTicks = -1;
@@ -474,7 +553,7 @@ void AudioEngine::handleMetronome()
 		|| currentPlayMode == Song::PlayMode::Song
 		|| currentPlayMode == Song::PlayMode::Pattern;
 
-	if (!metronomeSupported || !m_metronomeActive || song->isExporting())
+	if (!m_metronome || !metronomeSupported || !m_metronomeActive || song->isExporting())
 	{
 		return;
 	}
@@ -496,11 +575,13 @@ void AudioEngine::handleMetronome()
 
 	if (ticks % (ticksPerBar / 1) == 0)
 	{
-		addPlayHandle(new SamplePlayHandle("misc/metronome02.ogg"));
+		m_metronome->handle.restart(&m_metronome->barClick);
+		m_metronome->playing = true;
 	}
 	else if (ticks % (ticksPerBar / numerator) == 0)
 	{
-		addPlayHandle(new SamplePlayHandle("misc/metronome01.ogg"));
+		m_metronome->handle.restart(&m_metronome->beatClick);
+		m_metronome->playing = true;
 	}
 
 	lastMetroTicks = ticks;
@@ -40,9 +40,26 @@ namespace lmms
 {
 
 AudioEngineWorkerThread::JobQueue AudioEngineWorkerThread::globalJobQueue;
+AudioEngineWorkerThread::StealingJobQueue AudioEngineWorkerThread::stealingJobQueue;
+AudioEngineWorkerThread::Scheduler AudioEngineWorkerThread::s_scheduler =
+											AudioEngineWorkerThread::Scheduler::SharedQueue;
 QWaitCondition * AudioEngineWorkerThread::queueReadyWaitCond = nullptr;
 QList<AudioEngineWorkerThread *> AudioEngineWorkerThread::workerThreads;
 
+// deque index of the current thread, see AudioEngineWorkerThread::m_index
+static thread_local int s_workerIndex = 0;
+
+// number of empty polling rounds after which a thread gives up looking for
+// dynamically added jobs, respectively parks in StealingJobQueue::wait()
+static constexpr int IdleSpinCount = 256;
+
+static inline void cpuRelax()
+{
+#ifdef __SSE__
+	_mm_pause();
+#endif
+}
+
 // implementation of internal JobQueue
 void AudioEngineWorkerThread::JobQueue::reset( OperationMode _opMode )
 {
@@ -101,9 +118,155 @@ void AudioEngineWorkerThread::JobQueue::wait()
 {
 	while (m_itemsDone < m_writeIndex)
 	{
-#ifdef __SSE__
-		_mm_pause();
-#endif
+		cpuRelax();
+	}
+}
+
+
+
+
+// implementation of work-stealing job queue
+void AudioEngineWorkerThread::StealingJobQueue::init( int numDeques )
+{
+	m_deques.clear();
+	for( int i = 0; i < numDeques; ++i )
+	{
+		m_deques.push_back( std::make_unique<Deque>() );
+	}
+	m_pending = 0;
+}
+
+
+
+
+void AudioEngineWorkerThread::StealingJobQueue::reset( OperationMode _opMode )
+{
+	// the deques are not rewound here - stragglers of the previous round may
+	// still be looking at them, and an empty deque stays empty no matter
+	// where its indices are
+	m_pending = 0;
+	m_opMode = _opMode;
+}
+
+
+
+
+void AudioEngineWorkerThread::StealingJobQueue::addJob( ThreadableJob * _job )
+{
+	if( _job->requiresProcessing() )
+	{
+		_job->queue();
+		++m_pending;
+		if( !m_deques[s_workerIndex]->push( _job ) )
+		{
+			qWarning() << "Job queue is full!";
+			// process it right away instead of dropping it
+			_job->process();
+			jobDone();
+		}
+	}
+}
+
+
+
+
+ThreadableJob * AudioEngineWorkerThread::StealingJobQueue::steal( int _thief )
+{
+	const int numDeques = static_cast<int>( m_deques.size() );
+	// start at a different victim per thief so they don't all hit the same deque
+	for( int i = 1; i < numDeques; ++i )
+	{
+		auto& victim = *m_deques[( _thief + i ) % numDeques];
+		while( !victim.empty() )
+		{
+			if( ThreadableJob * job = victim.steal() )
+			{
+				return job;
+			}
+			cpuRelax();
+		}
+	}
+	return nullptr;
+}
+
+
+
+
+ThreadableJob * AudioEngineWorkerThread::StealingJobQueue::nextJob( int _workerIndex )
+{
+	ThreadableJob * job = m_deques[_workerIndex]->pop();
+	return job ? job : steal( _workerIndex );
+}
+
+
+
+
+void AudioEngineWorkerThread::StealingJobQueue::jobDone()
+{
+	if( m_pending.fetch_sub( 1 ) == 1 && m_waiting )
+	{
+		QMutexLocker lock( &m_waitMutex );
+		m_allDone.wakeAll();
+	}
+}
+
+
+
+
+void AudioEngineWorkerThread::StealingJobQueue::run( int _workerIndex )
+{
+	int idleRounds = 0;
+	while( m_pending > 0 )
+	{
+		if( ThreadableJob * job = nextJob( _workerIndex ) )
+		{
+			job->process();
+			jobDone();
+			idleRounds = 0;
+		}
+		// in static mode an empty pass means all jobs have been taken,
+		// in dynamic mode running jobs may still add new ones for a while
+		else if( m_opMode == OperationMode::Static || ++idleRounds > IdleSpinCount )
+		{
+			break;
+		}
+		else
+		{
+			cpuRelax();
+		}
+	}
+}
+
+
+
+
+void AudioEngineWorkerThread::StealingJobQueue::wait()
+{
+	// help out and spin for a short while before parking - most of the time
+	// the remaining jobs are almost done when we get here
+	for( int i = 0; i < IdleSpinCount && m_pending > 0; ++i )
+	{
+		if( ThreadableJob * job = nextJob( 0 ) )
+		{
+			job->process();
+			jobDone();
+			i = 0;
+		}
+		else
+		{
+			cpuRelax();
+		}
+	}
+
+	if( m_pending > 0 )
+	{
+		QMutexLocker lock( &m_waitMutex );
+		m_waiting = true;
+		while( m_pending > 0 )
+		{
+			m_allDone.wait( &m_waitMutex );
+		}
+		m_waiting = false;
 	}
 }
 
@@ -115,6 +278,7 @@ void AudioEngineWorkerThread::JobQueue::wait()
 
 AudioEngineWorkerThread::AudioEngineWorkerThread( AudioEngine* audioEngine ) :
 	QThread( audioEngine ),
+	m_index( workerThreads.size() + 1 ),
 	m_quit( false )
 {
 	// initialize global static data
@@ -151,14 +315,35 @@ void AudioEngineWorkerThread::quit()
 
 
 
+void AudioEngineWorkerThread::setScheduler( Scheduler _scheduler, int _numWorkers )
+{
+	s_scheduler = _scheduler;
+	if( s_scheduler == Scheduler::WorkStealing )
+	{
+		// one deque per started worker plus one for the calling thread
+		stealingJobQueue.init( _numWorkers + 1 );
+	}
+}
+
+
+
+
 void AudioEngineWorkerThread::startAndWaitForJobs()
 {
 	queueReadyWaitCond->wakeAll();
 	// The last worker-thread is never started. Instead it's processed "inline"
 	// i.e. within the global AudioEngine thread. This way we can reduce latencies
 	// that otherwise would be caused by synchronizing with another thread.
-	globalJobQueue.run();
-	globalJobQueue.wait();
+	if( s_scheduler == Scheduler::WorkStealing )
+	{
+		stealingJobQueue.run( 0 );
+		stealingJobQueue.wait();
+	}
+	else
+	{
+		globalJobQueue.run();
+		globalJobQueue.wait();
+	}
 }
 
 
@@ -167,13 +352,21 @@ void AudioEngineWorkerThread::startAndWaitForJobs()
 void AudioEngineWorkerThread::run()
 {
 	disable_denormals();
+	s_workerIndex = m_index;
 
 	QMutex m;
 	while( m_quit == false )
 	{
 		m.lock();
 		queueReadyWaitCond->wait( &m );
-		globalJobQueue.run();
+		if( s_scheduler == Scheduler::WorkStealing )
+		{
+			stealingJobQueue.run( m_index );
+		}
+		else
+		{
+			globalJobQueue.run();
+		}
 		m.unlock();
 	}
 }
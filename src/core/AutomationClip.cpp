@@ -27,6 +27,7 @@
 #include "AutomationClip.h"
 
 #include "AutomationNode.h"
+#include "AutomationRoutingTable.h"
 #include "AutomationClipView.h"
 #include "AutomationTrack.h"
 #include "LocaleHelper.h"
@@ -35,6 +36,7 @@
 #include "ProjectJournal.h"
 #include "Song.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace lmms
@@ -101,6 +103,8 @@ AutomationClip::AutomationClip( const AutomationClip & _clip_to_copy ) :
 		// Sets the node's clip to this one
 		m_timeMap[POS(it)].setClip(this);
 	}
+	compileCurve();
+
 	if (!getTrack()){ return; }
 	switch( getTrack()->trackContainer()->type() )
 	{
@@ -116,6 +120,14 @@ AutomationClip::AutomationClip( const AutomationClip & _clip_to_copy ) :
 	}
 }
 
+AutomationClip::~AutomationClip()
+{
+	delete m_curve.load();
+}
+
+
+
+
 bool AutomationClip::addObject( AutomatableModel * _obj, bool _search_dup )
 {
 	QMutexLocker m(&m_clipMutex);
@@ -133,6 +145,7 @@ bool AutomationClip::addObject( AutomatableModel * _obj, bool _search_dup )
 	}
 
 	m_objects.push_back(_obj);
+	AutomationRoutingTable::invalidate();
 
 	connect( _obj, SIGNAL(destroyed(lmms::jo_id_t)),
 			this, SLOT(objectDestroyed(lmms::jo_id_t)),
@@ -156,6 +169,7 @@ void AutomationClip::setProgressionType(
 		_new_progression_type == ProgressionType::CubicHermite )
 	{
 		m_progressionType = _new_progression_type;
+		compileCurve();
 		emit dataChanged();
 	}
 }
@@ -173,6 +187,7 @@ void AutomationClip::setTension( QString _new_tension )
 	if( ok && nt > -0.01 && nt < 1.01 )
 	{
 		m_tension = nt;
+		compileCurve();
 	}
 }
 
@@ -551,6 +566,7 @@ TimePos AutomationClip::setDragValue(
 			it.value().setInTangent(m_dragInTan);
 			it.value().setOutTangent(m_dragOutTan);
 			it.value().setLockedTangents(true);
+			compileCurve();
 		}
 	}
 
@@ -573,87 +589,158 @@ void AutomationClip::applyDragValue()
 
 
 
+namespace
+{
+
+//! Counts a reader of the compiled curve for as long as it is in scope
+class CurveReadGuard
+{
+public:
+	CurveReadGuard(std::atomic_int& readers) :
+		m_readers(readers)
+	{
+		m_readers.fetch_add(1);
+	}
+
+	~CurveReadGuard()
+	{
+		m_readers.fetch_sub(1);
+	}
+
+private:
+	std::atomic_int& m_readers;
+};
+
+} // namespace
+
+
+
+
 float AutomationClip::valueAt( const TimePos & _time ) const
 {
-	QMutexLocker m(&m_clipMutex);
+	CurveReadGuard guard(m_curveReaders);
+	const CompiledCurve* curve = m_curve.load();
+	if (!curve) { return 0; }
+
+	std::size_t cursor = m_curveCursor.load(std::memory_order_relaxed);
+	const float value = valueAt(*curve, _time.getTicks(), cursor);
+	m_curveCursor.store(cursor, std::memory_order_relaxed);
+	return value;
+}
+
+
+
 
-	if( m_timeMap.isEmpty() )
+void AutomationClip::valuesAt(float startTick, float tickStep, std::size_t count, float* out) const
+{
+	CurveReadGuard guard(m_curveReaders);
+	const CompiledCurve* curve = m_curve.load();
+	if (!curve)
 	{
-		return 0;
+		std::fill(out, out + count, 0.f);
+		return;
 	}
 
-	// If we have a node at that time, just return its value
-	if (m_timeMap.contains(_time))
+	std::size_t cursor = m_curveCursor.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < count; ++i)
 	{
-		// When the time is exactly the node's time, we want the inValue
-		return m_timeMap[_time].getInValue();
+		out[i] = valueAt(*curve, startTick + i * tickStep, cursor);
 	}
+	m_curveCursor.store(cursor, std::memory_order_relaxed);
+}
+
 
-	// lowerBound returns next value with equal or greater key. Since we already
-	// checked if the key contains a node, we know the returned node has a greater
-	// key than _time. Therefore we take the previous element to calculate the current value
-	timeMap::const_iterator v = m_timeMap.lowerBound(_time);
 
-	if( v == m_timeMap.begin() )
+
+float AutomationClip::valueAt(const CompiledCurve& curve, float time, std::size_t& cursor)
+{
+	const auto& positions = curve.positions;
+	if (positions.empty() || time < positions.front()) { return 0; }
+
+	// Find the last node at or before time. Try the segment of the previous
+	// lookup and the one after it before falling back to a binary search.
+	const std::size_t last = positions.size() - 1;
+	if (cursor <= last && positions[cursor] <= time)
 	{
-		return 0;
+		if (cursor < last && positions[cursor + 1] <= time)
+		{
+			++cursor;
+			if (cursor < last && positions[cursor + 1] <= time)
+			{
+				cursor = std::upper_bound(positions.begin() + cursor, positions.end(), time) - positions.begin() - 1;
+			}
+		}
 	}
-	if( v == m_timeMap.end() )
+	else
 	{
-		// When the time is after the last node, we want the outValue of it
-		return OUTVAL(v - 1);
+		cursor = std::upper_bound(positions.begin(), positions.end(), time) - positions.begin() - 1;
 	}
 
-	return valueAt(v - 1, _time - POS(v - 1));
+	const CurveSegment& s = curve.segments[cursor];
+	const float offset = time - positions[cursor];
+
+	// When the time is exactly the node's time, we want the inValue
+	if (offset == 0) { return s.inValue; }
+
+	const float x = offset * s.scale;
+	return ((s.c3 * x + s.c2) * x + s.c1) * x + s.c0;
 }
 
 
 
 
-// This method will get the value at an offset from a node, so we use the outValue of
-// that node and the inValue of the next node for the calculations.
-float AutomationClip::valueAt( timeMap::const_iterator v, int offset ) const
+void AutomationClip::compileCurve()
 {
 	QMutexLocker m(&m_clipMutex);
 
-	// We never use it with offset 0, but doesn't hurt to return a correct
-	// value if we do
-	if (offset == 0) { return INVAL(v); }
+	auto curve = std::make_unique<CompiledCurve>();
+	curve->positions.reserve(m_timeMap.size());
+	curve->segments.reserve(m_timeMap.size());
 
-	if (m_progressionType == ProgressionType::Discrete)
-	{
-		return OUTVAL(v);
-	}
-	else if( m_progressionType == ProgressionType::Linear )
+	for (auto it = m_timeMap.cbegin(); it != m_timeMap.cend(); ++it)
 	{
-		float slope =
-			(INVAL(v + 1) - OUTVAL(v))
-			/ (POS(v + 1) - POS(v));
+		// After the last node (and for discrete curves) the outValue is held
+		CurveSegment s{INVAL(it), 0.f, OUTVAL(it), 0.f, 0.f, 0.f};
 
-		return OUTVAL(v) + offset * slope;
-	}
-	else /* ProgressionType::CubicHermite */
-	{
-		// Implements a Cubic Hermite spline as explained at:
-		// http://en.wikipedia.org/wiki/Cubic_Hermite_spline#Unit_interval_.280.2C_1.29
-		//
-		// Note that we are not interpolating a 2 dimensional point over
-		// time as the article describes.  We are interpolating a single
-		// value: y.  To make this work we map the values of x that this
-		// segment spans to values of t for t = 0.0 -> 1.0 and scale the
-		// tangents _m1 and _m2
-		int numValues = (POS(v + 1) - POS(v));
-		float t = (float) offset / (float) numValues;
-		float m1 = OUTTAN(v) * numValues * m_tension;
-		float m2 = INTAN(v + 1) * numValues * m_tension;
-
-		auto t2 = pow(t, 2);
-		auto t3 = pow(t, 3);
-		return (2 * t3 - 3 * t2 + 1) * OUTVAL(v)
-			+ (t3 - 2 * t2 + t) * m1
-			+ (-2 * t3 + 3 * t2) * INVAL(v + 1)
-			+ (t3 - t2) * m2;
+		if (it + 1 != m_timeMap.cend())
+		{
+			const int numValues = POS(it + 1) - POS(it);
+			if (m_progressionType == ProgressionType::Linear)
+			{
+				s.scale = 1.f;
+				s.c1 = (INVAL(it + 1) - OUTVAL(it)) / numValues;
+			}
+			else if (m_progressionType == ProgressionType::CubicHermite)
+			{
+				// Implements a Cubic Hermite spline as explained at:
+				// http://en.wikipedia.org/wiki/Cubic_Hermite_spline#Unit_interval_.280.2C_1.29
+				//
+				// Note that we are not interpolating a 2 dimensional point over
+				// time as the article describes.  We are interpolating a single
+				// value: y.  To make this work we map the values of x that this
+				// segment spans to values of t for t = 0.0 -> 1.0 and scale the
+				// tangents m1 and m2. The basis functions are expanded into the
+				// coefficients of a cubic polynomial in t.
+				const float p1 = OUTVAL(it);
+				const float p2 = INVAL(it + 1);
+				const float m1 = OUTTAN(it) * numValues * m_tension;
+				const float m2 = INTAN(it + 1) * numValues * m_tension;
+				s.scale = 1.f / numValues;
+				s.c1 = m1;
+				s.c2 = -3 * p1 + 3 * p2 - 2 * m1 - m2;
+				s.c3 = 2 * p1 - 2 * p2 + m1 + m2;
+			}
+		}
+
+		curve->positions.push_back(POS(it));
+		curve->segments.push_back(s);
 	}
+
+	const CompiledCurve* old = m_curve.exchange(curve.release());
+	if (old) { m_retiredCurves.emplace_back(old); }
+
+	// Readers that started after the exchange can only see the new curve
+	if (m_curveReaders.load() == 0) { m_retiredCurves.clear(); }
 }
 
 
@@ -672,10 +759,7 @@ float *AutomationClip::valuesAfter( const TimePos & _time ) const
 	int numValues = POS(v + 1) - POS(v);
 	auto ret = new float[numValues];
 
-	for( int i = 0; i < numValues; i++ )
-	{
-		ret[i] = valueAt( v, i );
-	}
+	valuesAt(POS(v), 1.f, numValues, ret);
 
 	return ret;
 }
@@ -936,6 +1020,7 @@ void AutomationClip::loadSettings( const QDomElement & _this )
 	}
 
 	if (shouldGenerateTangents) { generateTangents(); }
+	else { compileCurve(); }
 }
 
 
@@ -1120,6 +1205,7 @@ void AutomationClip::clear()
 	QMutexLocker m(&m_clipMutex);
 
 	m_timeMap.clear();
+	compileCurve();
 
 	emit dataChanged();
 }
@@ -1147,6 +1233,7 @@ void AutomationClip::objectDestroyed( jo_id_t _id )
 			break;
 		}
 	}
+	AutomationRoutingTable::invalidate();
 
 	emit dataChanged();
 }
@@ -1167,6 +1254,7 @@ void AutomationClip::cleanObjects()
 		else
 		{
 			it = m_objects.erase( it );
+			AutomationRoutingTable::invalidate();
 		}
 	}
 }
@@ -1240,6 +1328,8 @@ void AutomationClip::generateTangents(timeMap::iterator it, int numToGenerate)
 			}
 		}
 	}
+
+	compileCurve();
 }
 
 std::vector<Track*> AutomationClip::combineAllTracks()
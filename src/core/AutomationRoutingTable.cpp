@@ -0,0 +1,326 @@
+/*
+ * AutomationRoutingTable.cpp - persistent mapping of automation clips to the
+ *                              models they automate
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "AutomationRoutingTable.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "AutomationClip.h"
+#include "Engine.h"
+#include "PatternClip.h"
+#include "PatternStore.h"
+#include "PatternTrack.h"
+
+namespace lmms
+{
+
+
+std::atomic<unsigned> AutomationRoutingTable::s_revision{0};
+
+
+void AutomationRoutingTable::invalidate()
+{
+	s_revision.fetch_add(1, std::memory_order_release);
+}
+
+
+
+
+bool AutomationRoutingTable::isValidFor(int clipNum) const
+{
+	return m_valid && m_clipNum == clipNum && m_revision == s_revision.load(std::memory_order_acquire);
+}
+
+
+
+
+void AutomationRoutingTable::rebuild(const TrackList& tracks, int clipNum)
+{
+	// Read the revision first, so edits during the rebuild cause another one
+	m_revision = s_revision.load(std::memory_order_acquire);
+	m_clipNum = clipNum;
+	m_valid = true;
+
+	auto oldSlots = std::move(m_slots);
+	m_slots.clear();
+	m_routes.clear();
+	m_routeSlots.clear();
+	m_recordableClips.clear();
+
+	QHash<AutomatableModel*, std::size_t> slotIndex;
+	addRoutes(tracks, clipNum, slotIndex);
+
+	for (Track* track : tracks)
+	{
+		if (track->type() != Track::Type::Automation) { continue; }
+		for (Clip* clip : track->getClips())
+		{
+			m_recordableClips.push_back(static_cast<AutomationClip*>(clip));
+		}
+	}
+
+	// Keep track of which models were automated in the last tick, so that
+	// apply() can give the ones without automation back to their controllers
+	for (const auto& oldSlot : oldSlots)
+	{
+		AutomatableModel* model = oldSlot.model.data();
+		if (!model || !oldSlot.automated) { continue; }
+
+		const auto it = slotIndex.constFind(model);
+		if (it != slotIndex.constEnd())
+		{
+			m_slots[*it].automated = true;
+		}
+		else if (model->controllerConnection())
+		{
+			model->setUseControllerValue(true);
+		}
+	}
+}
+
+
+
+
+void AutomationRoutingTable::addRoutes(const TrackList& tracks, int clipNum,
+	QHash<AutomatableModel*, std::size_t>& slotIndex)
+{
+	std::vector<std::pair<Track*, Clip*>> clips;
+	for (Track* track : tracks)
+	{
+		switch (track->type())
+		{
+		case Track::Type::Automation:
+		case Track::Type::HiddenAutomation:
+		case Track::Type::Pattern:
+			break;
+		default:
+			continue;
+		}
+
+		if (clipNum < 0)
+		{
+			for (Clip* clip : track->getClips())
+			{
+				clips.emplace_back(track, clip);
+			}
+		}
+		else
+		{
+			Q_ASSERT(track->numOfClips() > clipNum);
+			clips.emplace_back(track, track->getClip(clipNum));
+		}
+	}
+
+	if (clipNum < 0)
+	{
+		// Later clips override earlier ones regardless of their track, as in
+		// TrackContainer::automatedValuesFromTracks()
+		std::stable_sort(clips.begin(), clips.end(),
+			[](const auto& a, const auto& b) { return Clip::comparePosition(a.second, b.second); });
+	}
+
+	for (const auto& [track, clip] : clips)
+	{
+		if (auto p = dynamic_cast<AutomationClip*>(clip))
+		{
+			Route route{track, clip, -1, m_routeSlots.size(), 0, 0};
+			for (const auto& model : p->objects())
+			{
+				if (!model) { continue; }
+
+				auto it = slotIndex.constFind(model);
+				if (it == slotIndex.constEnd())
+				{
+					it = slotIndex.insert(model, m_slots.size());
+					m_slots.push_back(Slot{model, 0.f, false, false, false});
+				}
+				m_routeSlots.push_back(*it);
+				++route.numSlots;
+			}
+			m_routes.push_back(route);
+		}
+		else if (dynamic_cast<PatternClip*>(clip))
+		{
+			const int patternIndex = static_cast<PatternTrack*>(track)->patternIndex();
+			const std::size_t routeIndex = m_routes.size();
+			m_routes.push_back(Route{track, clip, patternIndex, 0, 0, 0});
+			addRoutes(Engine::patternStore()->tracks(), patternIndex, slotIndex);
+			m_routes[routeIndex].end = m_routes.size();
+		}
+	}
+}
+
+
+
+
+void AutomationRoutingTable::evaluate(TimePos time)
+{
+	for (auto& slot : m_slots)
+	{
+		slot.wasAutomated = slot.automated;
+		slot.automated = false;
+		slot.recorded = false;
+	}
+
+	evaluateRoutes(0, m_routes.size(), time);
+}
+
+
+
+
+void AutomationRoutingTable::evaluateRoutes(std::size_t begin, std::size_t end, TimePos time)
+{
+	for (std::size_t i = begin; i < end;)
+	{
+		const Route& route = m_routes[i];
+		const bool active = !route.track->isMuted() && !route.clip->isMuted()
+			&& route.clip->startPosition() <= time;
+
+		if (route.patternIndex >= 0)
+		{
+			if (active)
+			{
+				const auto patternLength = Engine::patternStore()->lengthOfPattern(route.patternIndex)
+					* TimePos::ticksPerBar();
+				TimePos patTime = time - route.clip->startPosition();
+				patTime = std::min(patTime, route.clip->length());
+				patTime = patTime % patternLength;
+
+				// later routes override earlier ones, so the pattern is evaluated in place
+				evaluateRoutes(i + 1, route.end, patternTime(patTime, route.patternIndex));
+			}
+			i = route.end;
+			continue;
+		}
+
+		++i;
+		auto p = static_cast<AutomationClip*>(route.clip);
+		if (!active || !p->hasAutomation()) { continue; }
+
+		TimePos relTime = time - p->startPosition();
+		if (!p->getAutoResize())
+		{
+			relTime = std::min(relTime, p->length());
+		}
+		const float value = p->valueAt(relTime);
+
+		for (std::size_t s = route.firstSlot; s < route.firstSlot + route.numSlots; ++s)
+		{
+			Slot& slot = m_slots[m_routeSlots[s]];
+			slot.value = value;
+			slot.automated = true;
+		}
+	}
+}
+
+
+
+
+void AutomationRoutingTable::markRecorded(const AutomatableModel* model)
+{
+	for (auto& slot : m_slots)
+	{
+		if (slot.model.data() == model)
+		{
+			slot.recorded = true;
+			return;
+		}
+	}
+}
+
+
+
+
+void AutomationRoutingTable::apply()
+{
+	for (auto& slot : m_slots)
+	{
+		AutomatableModel* model = slot.model.data();
+		if (!model) { continue; }
+
+		if (!slot.automated)
+		{
+			// The model stopped being automated by an automation clip,
+			// so move the control back to any connected controller again
+			if (slot.wasAutomated && model->controllerConnection())
+			{
+				model->setUseControllerValue(true);
+			}
+		}
+		else if (!slot.recorded)
+		{
+			model->setAutomatedValue(slot.value);
+		}
+		else if (!model->useControllerValue())
+		{
+			model->setUseControllerValue(true);
+		}
+	}
+}
+
+
+
+
+void AutomationRoutingTable::release()
+{
+	for (auto& slot : m_slots)
+	{
+		if (slot.automated && slot.model)
+		{
+			slot.model->setUseControllerValue(true);
+		}
+		slot.automated = false;
+		slot.wasAutomated = false;
+	}
+}
+
+
+
+
+void AutomationRoutingTable::clear()
+{
+	m_valid = false;
+	m_routes.clear();
+	m_routeSlots.clear();
+	m_slots.clear();
+	m_recordableClips.clear();
+}
+
+
+
+
+TimePos AutomationRoutingTable::patternTime(TimePos time, int patternIndex)
+{
+	const auto lengthTicks = Engine::patternStore()->lengthOfPattern(patternIndex) * TimePos::ticksPerBar();
+	if (time > lengthTicks)
+	{
+		time = lengthTicks;
+	}
+	return time + TimePos::ticksPerBar() * patternIndex;
+}
+
+
+} // namespace lmms
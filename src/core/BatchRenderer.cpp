@@ -0,0 +1,217 @@
+/*
+ * BatchRenderer.cpp - renders a list of projects with one engine
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "BatchRenderer.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QTimer>
+
+#include "Engine.h"
+#include "RenderManager.h"
+#include "Song.h"
+
+namespace lmms
+{
+
+BatchRenderer::BatchRenderer(const AudioEngine::qualitySettings& qualitySettings,
+		const OutputSettings& outputSettings,
+		ProjectRenderer::ExportFileFormat format,
+		Mode mode,
+		bool exportLoop) :
+	m_qualitySettings(qualitySettings),
+	m_outputSettings(outputSettings),
+	m_format(format),
+	m_mode(mode),
+	m_exportLoop(exportLoop),
+	m_currentJob(0),
+	m_failedJobs(0)
+{
+}
+
+
+
+
+BatchRenderer::~BatchRenderer() = default;
+
+
+
+
+bool BatchRenderer::loadJobs(const QString& jobFile)
+{
+	QFile file(jobFile);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return false;
+	}
+
+	// relative paths in the job file are relative to the job file
+	const QDir jobDir = QFileInfo(jobFile).absoluteDir();
+
+	QTextStream stream(&file);
+	while (!stream.atEnd())
+	{
+		const QString line = stream.readLine().trimmed();
+		if (line.isEmpty() || line.startsWith('#')) { continue; }
+
+		const QStringList fields = line.split('\t');
+		Job job;
+		job.project = jobDir.absoluteFilePath(fields[0].trimmed());
+		if (fields.size() > 1 && !fields.last().trimmed().isEmpty())
+		{
+			job.output = jobDir.absoluteFilePath(fields.last().trimmed());
+		}
+		m_jobs.push_back(job);
+	}
+
+	return true;
+}
+
+
+
+
+QStringList BatchRenderer::projects() const
+{
+	QStringList projects;
+	for (const Job& job : m_jobs)
+	{
+		projects << job.project;
+	}
+	return projects;
+}
+
+
+
+
+void BatchRenderer::start()
+{
+	m_currentJob = 0;
+	m_failedJobs = 0;
+	m_batchTimer.start();
+	renderNextJob();
+}
+
+
+
+
+QString BatchRenderer::outputPathFor(const Job& job) const
+{
+	const QFileInfo projectInfo(job.project);
+	const QString base = projectInfo.absolutePath() + "/" + projectInfo.completeBaseName();
+
+	if (m_mode == Mode::Project)
+	{
+		return job.output.isEmpty()
+			? base + ProjectRenderer::getFileExtensionFromFormat(m_format)
+			: job.output;
+	}
+
+	// tracks are written into a directory, named after the project by default
+	return job.output.isEmpty() ? base : job.output;
+}
+
+
+
+
+void BatchRenderer::renderNextJob()
+{
+	m_renderManager.reset();
+
+	while (m_currentJob < m_jobs.size())
+	{
+		const Job& job = m_jobs[m_currentJob];
+		fprintf(stderr, "\n[%zu/%zu] %s\n", m_currentJob + 1, m_jobs.size(), qPrintable(job.project));
+
+		m_jobTimer.start();
+
+		if (!QFileInfo(job.project).isFile())
+		{
+			fprintf(stderr, "Project file not found, skipping\n");
+			++m_failedJobs;
+			++m_currentJob;
+			continue;
+		}
+
+		Engine::getSong()->loadProject(job.project);
+		if (Engine::getSong()->isEmpty())
+		{
+			fprintf(stderr, "The project is empty, skipping\n");
+			++m_failedJobs;
+			++m_currentJob;
+			continue;
+		}
+		Engine::getSong()->setExportLoop(m_exportLoop);
+
+		// file devices don't create missing directories, and failing to
+		// open the output would end the whole batch
+		const QString outputPath = outputPathFor(job);
+		QDir().mkpath(m_mode == Mode::Project ? QFileInfo(outputPath).absolutePath() : outputPath);
+
+		m_renderManager = std::make_unique<RenderManager>(m_qualitySettings, m_outputSettings, m_format, outputPath);
+		connect(m_renderManager.get(), SIGNAL(finished()), this, SLOT(jobFinished()));
+
+		auto progressTimer = new QTimer(m_renderManager.get());
+		connect(progressTimer, SIGNAL(timeout()), m_renderManager.get(), SLOT(updateConsoleProgress()));
+		progressTimer->start(200);
+
+		switch (m_mode)
+		{
+		case Mode::Project: m_renderManager->renderProject(); break;
+		case Mode::Tracks: m_renderManager->renderTracks(); break;
+		case Mode::Stems: m_renderManager->renderStems(); break;
+		}
+		return;
+	}
+
+	fprintf(stderr, "\nBatch done: %zu jobs, %d failed, %.2fs\n",
+		m_jobs.size(), m_failedJobs, m_batchTimer.elapsed() / 1000.0);
+	emit finished();
+}
+
+
+
+
+void BatchRenderer::jobFinished()
+{
+	if (const int failed = m_renderManager->failedRenders(); failed > 0)
+	{
+		fprintf(stderr, "\n[%zu/%zu] failed, %d output file(s) could not be written\n",
+			m_currentJob + 1, m_jobs.size(), failed);
+		++m_failedJobs;
+	}
+	else
+	{
+		fprintf(stderr, "\n[%zu/%zu] rendered in %.2fs\n",
+			m_currentJob + 1, m_jobs.size(), m_jobTimer.elapsed() / 1000.0);
+	}
+	++m_currentJob;
+
+	// the render manager is still emitting the signal that got us here,
+	// so continue once control is back in the event loop
+	QTimer::singleShot(0, this, SLOT(renderNextJob()));
+}
+
+} // namespace lmms
@@ -28,23 +28,249 @@
 
 #include "SampleFrame.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
+#include <memory>
+#include <new>
 
 
 namespace lmms
 {
 
+namespace
+{
+
+constexpr std::size_t CacheLineSize = 64;
+constexpr std::size_t FramesPerCacheLine = CacheLineSize / sizeof(SampleFrame);
+
+//! Number of free buffers a thread keeps for itself before handing them back
+constexpr std::size_t ThreadCacheSize = 16;
+
+
+//! One contiguous slab of buffers plus a lockless free list, which is a
+//! Treiber stack of buffer indices (offset by one, so 0 means empty) with
+//! an ABA tag in the upper half of the head word
+class BufferPool
+{
+public:
+	BufferPool(fpp_t frames, std::size_t count, std::unique_ptr<BufferPool> retired) :
+		m_frames(frames),
+		m_stride((frames + FramesPerCacheLine - 1) / FramesPerCacheLine * FramesPerCacheLine),
+		m_count(count),
+		m_slab(static_cast<SampleFrame*>(::operator new(
+			m_stride * m_count * sizeof(SampleFrame), std::align_val_t{CacheLineSize}))),
+		m_next(std::make_unique<std::atomic<std::uint32_t>[]>(count)),
+		m_head(count > 0 ? 1 : 0),
+		m_inUse(0),
+		m_highWaterMark(0),
+		m_outstanding(0),
+		m_retired(std::move(retired))
+	{
+		std::uninitialized_default_construct_n(m_slab, m_stride * m_count);
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			m_next[i] = i + 1 < m_count ? static_cast<std::uint32_t>(i + 2) : 0;
+		}
+	}
+
+	~BufferPool()
+	{
+		::operator delete(m_slab, std::align_val_t{CacheLineSize});
+	}
+
+	SampleFrame* pop()
+	{
+		auto head = m_head.load(std::memory_order_acquire);
+		while (true)
+		{
+			const auto top = static_cast<std::uint32_t>(head);
+			if (top == 0) { return nullptr; }
+
+			const std::uint64_t next = m_next[top - 1].load(std::memory_order_relaxed);
+			if (m_head.compare_exchange_weak(head, tagged(head, next),
+				std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				m_outstanding.fetch_add(1, std::memory_order_relaxed);
+				return m_slab + (top - 1) * m_stride;
+			}
+		}
+	}
+
+	void push(SampleFrame* buf)
+	{
+		const auto node = static_cast<std::uint32_t>((buf - m_slab) / m_stride + 1);
+		auto head = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			m_next[node - 1].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+		}
+		while (!m_head.compare_exchange_weak(head, tagged(head, node),
+				std::memory_order_release, std::memory_order_relaxed));
+		m_outstanding.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool contains(const SampleFrame* buf) const
+	{
+		return buf >= m_slab && buf < m_slab + m_stride * m_count;
+	}
+
+	void acquired()
+	{
+		const auto inUse = ++m_inUse;
+		auto highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+		while (inUse > highWaterMark
+			&& !m_highWaterMark.compare_exchange_weak(highWaterMark, inUse, std::memory_order_relaxed)) {}
+	}
+
+	void released() { --m_inUse; }
+
+	fpp_t frames() const { return m_frames; }
+	std::size_t count() const { return m_count; }
+	std::size_t inUse() const { return m_inUse; }
+	std::size_t highWaterMark() const { return m_highWaterMark; }
+
+	//! Number of buffers not on the free list, i.e. handed out or held by thread caches
+	std::size_t outstanding() const { return m_outstanding.load(std::memory_order_acquire); }
+
+	//! Pool replaced by this one, kept alive for buffers still handed out
+	BufferPool* retired() const { return m_retired.get(); }
+	std::unique_ptr<BufferPool> takeRetired() { return std::move(m_retired); }
+	void setRetired(std::unique_ptr<BufferPool> retired) { m_retired = std::move(retired); }
+
+private:
+	static std::uint64_t tagged(std::uint64_t oldHead, std::uint64_t node)
+	{
+		return ((oldHead >> 32) + 1) << 32 | node;
+	}
+
+	const fpp_t m_frames;
+	const std::size_t m_stride; // in frames, so every buffer starts on a cache line
+	const std::size_t m_count;
+	SampleFrame* const m_slab;
+	const std::unique_ptr<std::atomic<std::uint32_t>[]> m_next;
+
+	alignas(CacheLineSize) std::atomic<std::uint64_t> m_head;
+	alignas(CacheLineSize) std::atomic<std::size_t> m_inUse;
+	std::atomic<std::size_t> m_highWaterMark;
+	std::atomic<std::size_t> m_outstanding;
+
+	std::unique_ptr<BufferPool> m_retired;
+};
+
+
+struct ThreadCache
+{
+	~ThreadCache()
+	{
+		flush();
+	}
+
+	void flush()
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			pool->push(buffers[i]);
+		}
+		size = 0;
+	}
+
+	BufferPool* pool = nullptr;
+	std::array<SampleFrame*, ThreadCacheSize> buffers;
+	std::size_t size = 0;
+};
+
+
+// the newest pool owns all older ones, which are only replaced if the
+// period size changes and must stay alive until all their buffers came back,
+// see pruneRetired()
+std::unique_ptr<BufferPool> s_poolOwner;
+std::atomic<BufferPool*> s_pool = nullptr;
+std::atomic<std::size_t> s_heapFallbacks = 0;
+
+thread_local ThreadCache s_threadCache;
+
+
+BufferPool* owningPool(const SampleFrame* buf)
+{
+	for (auto pool = s_pool.load(std::memory_order_acquire); pool; pool = pool->retired())
+	{
+		if (pool->contains(buf)) { return pool; }
+	}
+	return nullptr;
+}
+
+
+//! Frees the pools of the given chain whose buffers are all back on their
+//! free list. Pools with buffers still out (or parked in the cache of another
+//! thread) stay in the chain until a later call finds them unused.
+std::unique_ptr<BufferPool> pruneRetired(std::unique_ptr<BufferPool> pool)
+{
+	while (pool && pool->outstanding() == 0)
+	{
+		pool = pool->takeRetired();
+	}
+	if (pool)
+	{
+		pool->setRetired(pruneRetired(pool->takeRetired()));
+	}
+	return pool;
+}
+
+} // namespace
+
+
 fpp_t BufferManager::s_framesPerPeriod;
 
 void BufferManager::init( fpp_t fpp )
 {
 	s_framesPerPeriod = fpp;
+
+	const auto current = s_pool.load();
+	if (current && current->frames() == fpp) { return; }
+
+	// give this thread's cached buffers back, so their pool may be freed
+	s_threadCache.flush();
+	s_threadCache.pool = nullptr;
+
+	s_pool = nullptr;
+	s_poolOwner = std::make_unique<BufferPool>(fpp, PoolSize, pruneRetired(std::move(s_poolOwner)));
+	s_pool = s_poolOwner.get();
 }
 
 
 SampleFrame* BufferManager::acquire()
 {
-	return new SampleFrame[s_framesPerPeriod];
+	const auto pool = s_pool.load(std::memory_order_acquire);
+	auto& cache = s_threadCache;
+	if (cache.pool != pool)
+	{
+		cache.flush();
+		cache.pool = pool;
+	}
+
+	SampleFrame* buf = nullptr;
+	if (cache.size > 0)
+	{
+		buf = cache.buffers[--cache.size];
+	}
+	else if (pool)
+	{
+		buf = pool->pop();
+	}
+
+	if (buf == nullptr)
+	{
+		// pool exhausted (or not initialized yet)
+		++s_heapFallbacks;
+		return new SampleFrame[s_framesPerPeriod];
+	}
+
+	pool->acquired();
+	zeroSampleFrames(buf, s_framesPerPeriod);
+	return buf;
 }
 
 void BufferManager::clear( SampleFrame* ab, const f_cnt_t frames, const f_cnt_t offset )
@@ -55,7 +281,47 @@ void BufferManager::clear( SampleFrame* ab, const f_cnt_t frames, const f_cnt_t
 
 void BufferManager::release( SampleFrame* buf )
 {
-	delete[] buf;
+	if (buf == nullptr) { return; }
+
+	const auto pool = owningPool(buf);
+	if (pool == nullptr)
+	{
+		delete[] buf;
+		return;
+	}
+
+	pool->released();
+
+	auto& cache = s_threadCache;
+	if (pool != cache.pool)
+	{
+		pool->push(buf);
+		return;
+	}
+
+	if (cache.size == ThreadCacheSize)
+	{
+		// hand the older half back so other threads can use it
+		for (std::size_t i = 0; i < ThreadCacheSize / 2; ++i)
+		{
+			pool->push(cache.buffers[i]);
+		}
+		std::move(cache.buffers.begin() + ThreadCacheSize / 2, cache.buffers.end(), cache.buffers.begin());
+		cache.size = ThreadCacheSize / 2;
+	}
+	cache.buffers[cache.size++] = buf;
+}
+
+
+BufferManager::Stats BufferManager::stats()
+{
+	const auto pool = s_pool.load();
+	return {
+		pool ? pool->count() : 0,
+		pool ? pool->inUse() : 0,
+		pool ? pool->highWaterMark() : 0,
+		s_heapFallbacks.load()
+	};
 }
 
 } // namespace lmms
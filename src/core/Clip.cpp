@@ -95,6 +95,10 @@ void Clip::movePosition( const TimePos & pos )
 	{
 		Engine::audioEngine()->requestChangeInModel();
 		m_startPosition = newPos;
+		if( getTrack() )
+		{
+			getTrack()->clipBoundsChanged();
+		}
 		Engine::audioEngine()->doneChangeInModel();
 		Engine::getSong()->updateLength();
 		emit positionChanged();
@@ -114,6 +118,10 @@ void Clip::movePosition( const TimePos & pos )
 void Clip::changeLength( const TimePos & length )
 {
 	m_length = length;
+	if( getTrack() )
+	{
+		getTrack()->clipBoundsChanged();
+	}
 	Engine::getSong()->updateLength();
 	emit lengthChanged();
 }
@@ -653,12 +653,14 @@ void ConfigManager::initPortableWorkingDir()
 	QString applicationPath = qApp->applicationDirPath();
 	m_workingDir = applicationPath + "/lmms-workspace/";
 	m_lmmsRcFile = applicationPath + "/.lmmsrc.xml";
+	m_cacheDir = m_workingDir + "cache/";
 }
 
 void ConfigManager::initInstalledWorkingDir()
 {
 	m_workingDir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/lmms/";
 	m_lmmsRcFile = QDir::home().absolutePath() +"/.lmmsrc.xml";
+	m_cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/lmms/";
 	// Detect < 1.2.0 working directory as a courtesy
 	if ( QFileInfo( QDir::home().absolutePath() + "/lmms/projects/" ).exists() )
 		m_workingDir = QDir::home().absolutePath() + "/lmms/";
@@ -28,6 +28,7 @@
 #include <QFile>
 #include <cmath>
 #include <cstring>
+#include <mutex>
 #include <sstream>
 
 #ifdef _MSC_VER
@@ -60,6 +61,9 @@ float phi[1200];
 long wavewords, wavemode = 0;
 float mem_t = 1.0f, mem_o = 1.0f, mem_n = 1.0f, mem_b = 1.0f, mem_tune = 1.0f, mem_time = 1.0f;
 
+// Guards the globals above, samples may be decoded on several threads at once
+std::mutex dsMutex;
+
 int DrumSynth::LongestEnv()
 {
 	float l = 0.f;
@@ -321,6 +325,8 @@ float DrumSynth::GetPrivateProfileFloat(const char* sec, const char* key, float
 
 int DrumSynth::GetDSFileSamples(QString dsfile, int16_t*& wave, int channels, sample_rate_t Fs)
 {
+	const auto lock = std::lock_guard{dsMutex};
+
 	// input file
 	char sec[32];
 	char ver[32];
@@ -36,6 +36,9 @@
 #include "Song.h"
 #include "BandLimitedWave.h"
 #include "Oscillator.h"
+#include "PerfLog.h"
+#include "ThreadPool.h"
+#include "fft_helpers.h"
 
 namespace lmms
 {
@@ -54,34 +57,79 @@ void* Engine::s_dndPluginKey = nullptr;
 
 
 
+namespace
+{
+
+//! Runs @p stage of Engine::init() on the thread pool and logs its duration
+template<typename Stage>
+std::future<void> startStage(const char* name, Stage stage)
+{
+	return ThreadPool::instance().enqueue([name, stage] {
+		PerfLogTimer timer(name);
+		stage();
+	});
+}
+
+} // namespace
+
 
-void Engine::init( bool renderOnly )
+
+
+void Engine::init( bool renderOnly, fpp_t renderFramesPerPeriod )
 {
 	Engine *engine = inst();
 
+	// Stages without QObjects run on the thread pool, in parallel to the
+	// ones below. QObjects are created here so they belong to this thread.
 	emit engine->initProgress(tr("Generating wavetables"));
 	// generate (load from file) bandlimited wavetables
-	BandLimitedWave::generateWaves();
-	//initilize oscillators
-	Oscillator::waveTableInit();
+	auto waves = startStage("Band-limited waves", &BandLimitedWave::generateWaves);
+	auto oscillators = startStage("Oscillator tables", [] {
+		// lets the FFTW_MEASURE plans below and in plugins skip measuring
+		loadFftwWisdom();
+		//initilize oscillators
+		Oscillator::waveTableInit();
+	});
+	auto ladspa = startStage("LADSPA plugins", [] { s_ladspaManager = new Ladspa2LMMS; });
 
 	emit engine->initProgress(tr("Initializing data structures"));
-	s_projectJournal = new ProjectJournal;
-	s_audioEngine = new AudioEngine( renderOnly );
-	s_song = new Song;
-	s_mixer = new Mixer;
-	s_patternStore = new PatternStore;
+	{
+		PerfLogTimer timer("Data structures");
+		s_projectJournal = new ProjectJournal;
+		s_audioEngine = new AudioEngine( renderOnly, renderFramesPerPeriod );
+	}
 
 #ifdef LMMS_HAVE_LV2
-	s_lv2Manager = new Lv2Manager;
-	s_lv2Manager->initPlugins();
+	// needs the audio engine's period size
+	auto lv2 = startStage("LV2 plugins", [] {
+		s_lv2Manager = new Lv2Manager;
+		s_lv2Manager->initPlugins();
+	});
 #endif
-	s_ladspaManager = new Ladspa2LMMS;
+
+	{
+		PerfLogTimer timer("Song and mixer");
+		s_song = new Song;
+		s_mixer = new Mixer;
+		s_patternStore = new PatternStore;
+		s_audioEngine->initMetronome();
+	}
 
 	s_projectJournal->setJournalling( true );
 
 	emit engine->initProgress(tr("Opening audio and midi devices"));
-	s_audioEngine->initDevices();
+	{
+		PerfLogTimer timer("Audio and MIDI devices");
+		s_audioEngine->initDevices();
+	}
+
+	emit engine->initProgress(tr("Loading plugins"));
+	waves.get();
+	oscillators.get();
+	ladspa.get();
+#ifdef LMMS_HAVE_LV2
+	lv2.get();
+#endif
 
 	PresetPreviewPlayHandle::init();
 
@@ -98,6 +146,7 @@ void Engine::destroy()
 	s_audioEngine->stopProcessing();
 
 	PresetPreviewPlayHandle::cleanup();
+	s_audioEngine->cleanupMetronome();
 
 	s_song->clearProject();
 
@@ -116,6 +165,8 @@ void Engine::destroy()
 
 	deleteHelper( &s_song );
 
+	saveFftwWisdom();
+
 	delete ConfigManager::inst();
 
 	// The oscillator FFT plans remain throughout the application lifecycle
@@ -150,15 +150,15 @@ void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
 
 	if( m_filterEnabledModel.value() )
 	{
-		QVarLengthArray<float> cutBuffer(frames);
-		QVarLengthArray<float> resBuffer(frames);
+		QVarLengthArray<float, MAXIMUM_RENDER_BUFFER_SIZE> cutBuffer(frames);
+		QVarLengthArray<float, MAXIMUM_RENDER_BUFFER_SIZE> resBuffer(frames);
 
 		int old_filter_cut = 0;
 		int old_filter_res = 0;
 
-		if( n->m_filter == nullptr )
+		if( !n->m_filter )
 		{
-			n->m_filter = std::make_unique<BasicFilters<>>( Engine::audioEngine()->outputSampleRate() );
+			n->m_filter.emplace( Engine::audioEngine()->outputSampleRate() );
 		}
 		n->m_filter->setFilterType( static_cast<BasicFilters<>::FilterType>(m_filterModel.value()) );
 
@@ -243,7 +243,7 @@ void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
 
 	if( m_envLfoParameters[static_cast<std::size_t>(Target::Volume)]->isUsed() )
 	{
-		QVarLengthArray<float> volBuffer(frames);
+		QVarLengthArray<float, MAXIMUM_RENDER_BUFFER_SIZE> volBuffer(frames);
 		m_envLfoParameters[static_cast<std::size_t>(Target::Volume)]->fillLevel( volBuffer.data(), envTotalFrames, envReleaseBegin, frames );
 
 		for( fpp_t frame = 0; frame < frames; ++frame )
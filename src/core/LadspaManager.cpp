@@ -33,6 +33,7 @@
 
 #include "ConfigManager.h"
 #include "LadspaManager.h"
+#include "PluginCache.h"
 #include "PluginFactory.h"
 
 
@@ -59,6 +60,9 @@ LadspaManager::LadspaManager()
 	ladspaDirectories.push_back( "/Library/Audio/Plug-Ins/LADSPA" );
 #endif
 
+	// Unchanged libraries are only loaded once a plugin of them is used
+	PluginCache cache( "ladspa" );
+
 	for (const auto& ladspaDirectory : ladspaDirectories)
 	{
 		// Skip empty entries as QDir will interpret it as the working directory
@@ -78,16 +82,24 @@ LadspaManager::LadspaManager()
 				continue;
 			}
 
+			QVariantMap cached;
+			if( cache.lookup( f, cached ) )
+			{
+				addCachedPlugins( cached.value( "plugins" ).toList(), f );
+				continue;
+			}
+
 			QLibrary plugin_lib( f.absoluteFilePath() );
 
 			if( plugin_lib.load() == true )
 			{
+				QVariantList plugins;
 				auto descriptorFunction = (LADSPA_Descriptor_Function)plugin_lib.resolve("ladspa_descriptor");
 				if( descriptorFunction != nullptr )
 				{
-					addPlugins( descriptorFunction,
-							f.fileName() );
+					plugins = addPlugins( descriptorFunction, f );
 				}
+				cache.insert( f, { { "plugins", plugins } } );
 			}
 			else
 			{
@@ -129,45 +141,93 @@ LadspaManagerDescription * LadspaManager::getDescription(
 
 
 
-void LadspaManager::addPlugins(
+QVariantList LadspaManager::addPlugins(
 		LADSPA_Descriptor_Function _descriptor_func,
-						const QString & _file )
+						const QFileInfo & _file )
 {
+	QVariantList plugins;
 	for (long pluginIndex = 0; const auto descriptor = _descriptor_func(pluginIndex); ++pluginIndex)
 	{
-		ladspa_key_t key( _file, QString( descriptor->Label ) );
-		if( m_ladspaManagerMap.contains( key ) )
-		{
-			continue;
-		}
-
 		auto plugIn = new LadspaManagerDescription;
 		plugIn->descriptorFunction = _descriptor_func;
+		plugIn->file = _file.absoluteFilePath();
 		plugIn->index = pluginIndex;
 		plugIn->inputChannels = getPluginInputs( descriptor );
 		plugIn->outputChannels = getPluginOutputs( descriptor );
+		plugIn->label = descriptor->Label;
+		plugIn->name = descriptor->Name;
+		plugIn->properties = descriptor->Properties;
+
+		plugins.append( QVariantMap{
+			{ "index", plugIn->index },
+			{ "label", plugIn->label },
+			{ "name", plugIn->name },
+			{ "inputs", plugIn->inputChannels },
+			{ "outputs", plugIn->outputChannels },
+			{ "properties", plugIn->properties } } );
+
+		addPlugin( ladspa_key_t( _file.fileName(), plugIn->label ), plugIn );
+	}
+	return plugins;
+}
+
+
+
+
+void LadspaManager::addCachedPlugins( const QVariantList & _plugins,
+						const QFileInfo & _file )
+{
+	for( const QVariant & plugin : _plugins )
+	{
+		const QVariantMap values = plugin.toMap();
+
+		auto plugIn = new LadspaManagerDescription;
+		plugIn->descriptorFunction = nullptr;
+		plugIn->file = _file.absoluteFilePath();
+		plugIn->index = values.value( "index" ).toUInt();
+		plugIn->inputChannels = values.value( "inputs" ).toUInt();
+		plugIn->outputChannels = values.value( "outputs" ).toUInt();
+		plugIn->label = values.value( "label" ).toString();
+		plugIn->name = values.value( "name" ).toString();
+		plugIn->properties = values.value( "properties" ).toInt();
+
+		addPlugin( ladspa_key_t( _file.fileName(), plugIn->label ), plugIn );
+	}
+}
+
 
-		if( plugIn->inputChannels == 0 && plugIn->outputChannels > 0 )
-		{
-			plugIn->type = LadspaPluginType::Source;
-		}
-		else if( plugIn->inputChannels > 0 &&
-				       plugIn->outputChannels > 0 )
-		{
-			plugIn->type = LadspaPluginType::Transfer;
-		}
-		else if( plugIn->inputChannels > 0 &&
-				       plugIn->outputChannels == 0 )
-		{
-			plugIn->type = LadspaPluginType::Sink;
-		}
-		else
-		{
-			plugIn->type = LadspaPluginType::Other;
-		}
 
-		m_ladspaManagerMap[key] = plugIn;
+
+void LadspaManager::addPlugin( const ladspa_key_t & _key,
+					LadspaManagerDescription * _description )
+{
+	if( m_ladspaManagerMap.contains( _key ) )
+	{
+		delete _description;
+		return;
 	}
+
+	auto plugIn = _description;
+	if( plugIn->inputChannels == 0 && plugIn->outputChannels > 0 )
+	{
+		plugIn->type = LadspaPluginType::Source;
+	}
+	else if( plugIn->inputChannels > 0 &&
+			       plugIn->outputChannels > 0 )
+	{
+		plugIn->type = LadspaPluginType::Transfer;
+	}
+	else if( plugIn->inputChannels > 0 &&
+			       plugIn->outputChannels == 0 )
+	{
+		plugIn->type = LadspaPluginType::Sink;
+	}
+	else
+	{
+		plugIn->type = LadspaPluginType::Other;
+	}
+
+	m_ladspaManagerMap[_key] = plugIn;
 }
 
 
@@ -255,8 +315,8 @@ l_sortable_plugin_t LadspaManager::getSortedPlugins()
 
 QString LadspaManager::getLabel( const ladspa_key_t & _plugin )
 {
-	const LADSPA_Descriptor * descriptor = getDescriptor( _plugin );
-	return( descriptor ? descriptor->Label : "" );
+	const LadspaManagerDescription * description = getDescription( _plugin );
+	return( description ? description->label : "" );
 }
 
 
@@ -286,8 +346,8 @@ bool LadspaManager::isInplaceBroken( const ladspa_key_t &  _plugin )
 bool LadspaManager::isRealTimeCapable(
 					const ladspa_key_t &  _plugin )
 {
-	const LADSPA_Descriptor * descriptor = getDescriptor( _plugin );
-	return( descriptor ? LADSPA_IS_HARD_RT_CAPABLE( descriptor->Properties )
+	const LadspaManagerDescription * description = getDescription( _plugin );
+	return( description ? LADSPA_IS_HARD_RT_CAPABLE( description->properties )
 					   : false );
 }
 
@@ -296,8 +356,8 @@ bool LadspaManager::isRealTimeCapable(
 
 QString LadspaManager::getName( const ladspa_key_t & _plugin )
 {
-	const LADSPA_Descriptor * descriptor = getDescriptor( _plugin );
-	return( descriptor ? descriptor->Name : "" );
+	const LadspaManagerDescription * description = getDescription( _plugin );
+	return( description ? description->name : "" );
 }
 
 
@@ -555,10 +615,21 @@ const LADSPA_Descriptor * LadspaManager::getDescriptor(const ladspa_key_t & _plu
 	{
 		auto const plugin = *it;
 
-		LADSPA_Descriptor_Function descriptorFunction = plugin->descriptorFunction;
-		const LADSPA_Descriptor* descriptor = descriptorFunction(plugin->index);
+		if (!plugin->descriptorFunction)
+		{
+			// known from the plugin cache, but not loaded yet
+			QLibrary library(plugin->file);
+			if (!library.load())
+			{
+				qWarning() << library.errorString();
+				return nullptr;
+			}
+			plugin->descriptorFunction = reinterpret_cast<LADSPA_Descriptor_Function>(
+				library.resolve("ladspa_descriptor"));
+			if (!plugin->descriptorFunction) { return nullptr; }
+		}
 
-		return descriptor;
+		return plugin->descriptorFunction(plugin->index);
 	}
 
 	return nullptr;
@@ -28,9 +28,16 @@
 #include <cstdio>
 #endif
 
+#include <atomic>
 #include <cmath>
 #include <QtGlobal>
 
+#if defined(_MSC_VER) && (defined(LMMS_HOST_X86) || defined(LMMS_HOST_X86_64))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#include "MixHelpersKernels.h"
 #include "ValueBuffer.h"
 #include "SampleFrame.h"
 
@@ -42,16 +49,176 @@ static bool s_NaNHandler;
 namespace lmms::MixHelpers
 {
 
-/*! \brief Function for applying MIXOP on all sample frames */
-template<typename MIXOP>
-static inline void run( SampleFrame* dst, const SampleFrame* src, int frames, const MIXOP& OP )
+static_assert(sizeof(SampleFrame) == DEFAULT_CHANNELS * sizeof(sample_t),
+	"the kernels treat SampleFrame arrays as interleaved samples");
+
+namespace
 {
-	for( int i = 0; i < frames; ++i )
+
+//! Portable fallback, one frame per "vector"
+struct Scalar
+{
+	struct Vec { float l, r; };
+	static constexpr int Width = 2;
+
+	static Vec load(const float* p) { return { p[0], p[1] }; }
+	static void store(float* p, Vec v) { p[0] = v.l; p[1] = v.r; }
+	static Vec set1(float x) { return { x, x }; }
+	static Vec setPairs(float l, float r) { return { l, r }; }
+	static Vec loadDuplicated(const float* c) { return { c[0], c[0] }; }
+
+	static Vec add(Vec a, Vec b) { return { a.l + b.l, a.r + b.r }; }
+	static Vec mul(Vec a, Vec b) { return { a.l * b.l, a.r * b.r }; }
+	static Vec min(Vec a, Vec b) { return { std::min(a.l, b.l), std::min(a.r, b.r) }; }
+	static Vec max(Vec a, Vec b) { return { std::max(a.l, b.l), std::max(a.r, b.r) }; }
+	static Vec swapPairs(Vec v) { return { v.r, v.l }; }
+
+	static Vec zeroNonFinite(Vec v)
+	{
+		return { std::isfinite(v.l) ? v.l : 0.f, std::isfinite(v.r) ? v.r : 0.f };
+	}
+
+	static bool anyAbsNotLess(Vec v, Vec threshold)
+	{
+		return std::fabs(v.l) >= threshold.l || std::fabs(v.r) >= threshold.r;
+	}
+
+	static bool anyNonZero(Vec v)
+	{
+		return v.l != 0.f || v.r != 0.f;
+	}
+};
+
+
+#if defined(LMMS_HOST_X86) || defined(LMMS_HOST_X86_64)
+bool cpuSupports(SimdLevel level)
+{
+#if defined(__GNUC__)
+	// also checks that the OS saves the AVX/AVX-512 registers
+	__builtin_cpu_init();
+	switch (level)
+	{
+	case SimdLevel::Sse2: return __builtin_cpu_supports("sse2");
+	case SimdLevel::Avx2: return __builtin_cpu_supports("avx2");
+	case SimdLevel::Avx512: return __builtin_cpu_supports("avx512f");
+	default: return false;
+	}
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	const bool sse2 = info[3] & (1 << 26);
+	const bool osxsave = info[2] & (1 << 27);
+	const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+	// XMM/YMM state, and additionally opmask/ZMM state for AVX-512
+	const bool osAvx = (xcr0 & 0x06) == 0x06;
+	const bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+	int extended[4] = {};
+	if (maxLeaf >= 7) { __cpuidex(extended, 7, 0); }
+
+	switch (level)
+	{
+	case SimdLevel::Sse2: return sse2;
+	case SimdLevel::Avx2: return osAvx && (extended[1] & (1 << 5));
+	case SimdLevel::Avx512: return osAvx512 && (extended[1] & (1 << 16));
+	default: return false;
+	}
+#else
+	return false;
+#endif
+}
+#endif
+
+
+const Kernels* kernelsFor(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::None: return &scalarKernels;
+#if defined(LMMS_HOST_X86) || defined(LMMS_HOST_X86_64)
+	case SimdLevel::Sse2: return cpuSupports(level) ? &sse2Kernels : nullptr;
+	case SimdLevel::Avx2: return cpuSupports(level) ? &avx2Kernels : nullptr;
+	case SimdLevel::Avx512: return cpuSupports(level) ? &avx512Kernels : nullptr;
+#elif defined(LMMS_HOST_ARM64)
+	// NEON is part of the base instruction set on AArch64
+	case SimdLevel::Neon: return &neonKernels;
+#endif
+	default: return nullptr;
+	}
+}
+
+
+std::atomic<const Kernels*> s_kernels{nullptr};
+std::atomic<SimdLevel> s_simdLevel{SimdLevel::None};
+
+
+const Kernels& kernels()
+{
+	const Kernels* k = s_kernels.load(std::memory_order_acquire);
+	if (k == nullptr)
+	{
+		// pick the widest instruction set the CPU supports
+		for (auto level : { SimdLevel::Avx512, SimdLevel::Avx2, SimdLevel::Sse2, SimdLevel::Neon, SimdLevel::None })
+		{
+			if (setSimdLevel(level)) { break; }
+		}
+		k = s_kernels.load(std::memory_order_acquire);
+	}
+	return *k;
+}
+
+
+inline float* samples(SampleFrame* frames)
+{
+	return reinterpret_cast<float*>(frames);
+}
+
+inline const float* samples(const SampleFrame* frames)
+{
+	return reinterpret_cast<const float*>(frames);
+}
+
+} // namespace
+
+
+const Kernels scalarKernels = makeKernels<Scalar>("scalar");
+
+
+
+SimdLevel simdLevel()
+{
+	kernels();
+	return s_simdLevel.load(std::memory_order_relaxed);
+}
+
+bool isSimdLevelSupported(SimdLevel level)
+{
+	return kernelsFor(level) != nullptr;
+}
+
+bool setSimdLevel(SimdLevel level)
+{
+	const Kernels* k = kernelsFor(level);
+	if (k == nullptr)
 	{
-		OP( dst[i], src[i] );
+		return false;
 	}
+
+	s_simdLevel.store(level, std::memory_order_relaxed);
+	s_kernels.store(k, std::memory_order_release);
+	return true;
 }
 
+const char* simdLevelName()
+{
+	return kernels().name;
+}
+
+
+
 /*! \brief Function for applying MIXOP on all sample frames - split source */
 template<typename MIXOP>
 static inline void run( SampleFrame* dst, const sample_t* srcLeft, const sample_t* srcRight, int frames, const MIXOP& OP )
@@ -69,15 +236,7 @@ bool isSilent( const SampleFrame* src, int frames )
 {
 	const float silenceThreshold = 0.0000001f;
 
-	for( int i = 0; i < frames; ++i )
-	{
-		if( fabsf( src[i][0] ) >= silenceThreshold || fabsf( src[i][1] ) >= silenceThreshold )
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return kernels().isSilent(samples(src), silenceThreshold, frames);
 }
 
 bool useNaNHandler()
@@ -98,111 +257,55 @@ bool sanitize( SampleFrame* src, int frames )
 		return false;
 	}
 
-	for (int f = 0; f < frames; ++f)
+	if (kernels().sanitize(samples(src), 1000.f, frames))
 	{
-		auto& currentFrame = src[f];
-
-		if (currentFrame.containsInf() || currentFrame.containsNaN())
-		{
-			#ifdef LMMS_DEBUG
-					// TODO don't use printf here
-					printf("Bad data, clearing buffer. frame: ");
-					printf("%d: value %f, %f\n", f, currentFrame.left(), currentFrame.right());
-			#endif
+		#ifdef LMMS_DEBUG
+				// TODO don't use printf here
+				printf("Bad data, clearing buffer.\n");
+		#endif
 
-			// Clear the whole buffer if a problem is found
-			zeroSampleFrames(src, frames);
+		// Clear the whole buffer if a problem is found
+		zeroSampleFrames(src, frames);
 
-			return true;
-		}
-		else
-		{
-			currentFrame.clamp(sample_t(-1000.0), sample_t(1000.0));
-		}
-	};
+		return true;
+	}
 
 	return false;
 }
 
 
-struct AddOp
-{
-	void operator()( SampleFrame& dst, const SampleFrame& src ) const
-	{
-		dst += src;
-	}
-} ;
-
 void add( SampleFrame* dst, const SampleFrame* src, int frames )
 {
-	run<>( dst, src, frames, AddOp() );
+	kernels().add(samples(dst), samples(src), frames);
 }
 
 
-
-struct AddMultipliedOp
-{
-	AddMultipliedOp( float coeff ) : m_coeff( coeff ) { }
-
-	void operator()( SampleFrame& dst, const SampleFrame& src ) const
-	{
-		dst += src * m_coeff;
-	}
-
-	const float m_coeff;
-} ;
-
-
 void addMultiplied( SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames )
 {
-	run<>( dst, src, frames, AddMultipliedOp(coeffSrc) );
+	kernels().addMultiplied(samples(dst), samples(src), coeffSrc, frames);
 }
 
 
-struct AddSwappedMultipliedOp
-{
-	AddSwappedMultipliedOp( float coeff ) : m_coeff( coeff ) { }
-
-	void operator()( SampleFrame& dst, const SampleFrame& src ) const
-	{
-		dst[0] += src[1] * m_coeff;
-		dst[1] += src[0] * m_coeff;
-	}
-
-	const float m_coeff;
-};
-
 void multiply(SampleFrame* dst, float coeff, int frames)
 {
-	for (int i = 0; i < frames; ++i)
-	{
-		dst[i] *= coeff;
-	}
+	kernels().multiply(samples(dst), coeff, frames);
 }
 
 void addSwappedMultiplied( SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames )
 {
-	run<>( dst, src, frames, AddSwappedMultipliedOp(coeffSrc) );
+	kernels().addSwappedMultiplied(samples(dst), samples(src), coeffSrc, frames);
 }
 
 
 void addMultipliedByBuffer( SampleFrame* dst, const SampleFrame* src, float coeffSrc, ValueBuffer * coeffSrcBuf, int frames )
 {
-	for( int f = 0; f < frames; ++f )
-	{
-		dst[f][0] += src[f][0] * coeffSrc * coeffSrcBuf->values()[f];
-		dst[f][1] += src[f][1] * coeffSrc * coeffSrcBuf->values()[f];
-	}
+	kernels().addMultipliedByBuffer(samples(dst), samples(src), coeffSrc, coeffSrcBuf->values(), frames);
 }
 
 void addMultipliedByBuffers( SampleFrame* dst, const SampleFrame* src, ValueBuffer * coeffSrcBuf1, ValueBuffer * coeffSrcBuf2, int frames )
 {
-	for( int f = 0; f < frames; ++f )
-	{
-		dst[f][0] += src[f][0] * coeffSrcBuf1->values()[f] * coeffSrcBuf2->values()[f];
-		dst[f][1] += src[f][1] * coeffSrcBuf1->values()[f] * coeffSrcBuf2->values()[f];
-	}
-
+	kernels().addMultipliedByBuffers(samples(dst), samples(src),
+		coeffSrcBuf1->values(), coeffSrcBuf2->values(), frames);
 }
 
 void addSanitizedMultipliedByBuffer( SampleFrame* dst, const SampleFrame* src, float coeffSrc, ValueBuffer * coeffSrcBuf, int frames )
@@ -214,11 +317,7 @@ void addSanitizedMultipliedByBuffer( SampleFrame* dst, const SampleFrame* src, f
 		return;
 	}
 
-	for( int f = 0; f < frames; ++f )
-	{
-		dst[f][0] += ( std::isinf( src[f][0] ) || std::isnan( src[f][0] ) ) ? 0.0f : src[f][0] * coeffSrc * coeffSrcBuf->values()[f];
-		dst[f][1] += ( std::isinf( src[f][1] ) || std::isnan( src[f][1] ) ) ? 0.0f : src[f][1] * coeffSrc * coeffSrcBuf->values()[f];
-	}
+	kernels().addSanitizedMultipliedByBuffer(samples(dst), samples(src), coeffSrc, coeffSrcBuf->values(), frames);
 }
 
 void addSanitizedMultipliedByBuffers( SampleFrame* dst, const SampleFrame* src, ValueBuffer * coeffSrcBuf1, ValueBuffer * coeffSrcBuf2, int frames )
@@ -230,32 +329,11 @@ void addSanitizedMultipliedByBuffers( SampleFrame* dst, const SampleFrame* src,
 		return;
 	}
 
-	for( int f = 0; f < frames; ++f )
-	{
-		dst[f][0] += ( std::isinf( src[f][0] ) || std::isnan( src[f][0] ) )
-			? 0.0f
-			: src[f][0] * coeffSrcBuf1->values()[f] * coeffSrcBuf2->values()[f];
-		dst[f][1] += ( std::isinf( src[f][1] ) || std::isnan( src[f][1] ) )
-			? 0.0f
-			: src[f][1] * coeffSrcBuf1->values()[f] * coeffSrcBuf2->values()[f];
-	}
-
+	kernels().addSanitizedMultipliedByBuffers(samples(dst), samples(src),
+		coeffSrcBuf1->values(), coeffSrcBuf2->values(), frames);
 }
 
 
-struct AddSanitizedMultipliedOp
-{
-	AddSanitizedMultipliedOp( float coeff ) : m_coeff( coeff ) { }
-
-	void operator()( SampleFrame& dst, const SampleFrame& src ) const
-	{
-		dst[0] += ( std::isinf( src[0] ) || std::isnan( src[0] ) ) ? 0.0f : src[0] * m_coeff;
-		dst[1] += ( std::isinf( src[1] ) || std::isnan( src[1] ) ) ? 0.0f : src[1] * m_coeff;
-	}
-
-	const float m_coeff;
-};
-
 void addSanitizedMultiplied( SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames )
 {
 	if ( !useNaNHandler() )
@@ -264,33 +342,13 @@ void addSanitizedMultiplied( SampleFrame* dst, const SampleFrame* src, float coe
 		return;
 	}
 
-	run<>( dst, src, frames, AddSanitizedMultipliedOp(coeffSrc) );
+	kernels().addSanitizedMultiplied(samples(dst), samples(src), coeffSrc, frames);
 }
 
 
-
-struct AddMultipliedStereoOp
-{
-	AddMultipliedStereoOp( float coeffLeft, float coeffRight )
-	{
-		m_coeffs[0] = coeffLeft;
-		m_coeffs[1] = coeffRight;
-	}
-
-	void operator()( SampleFrame& dst, const SampleFrame& src ) const
-	{
-		dst[0] += src[0] * m_coeffs[0];
-		dst[1] += src[1] * m_coeffs[1];
-	}
-
-	std::array<float, 2> m_coeffs;
-} ;
-
-
 void addMultipliedStereo( SampleFrame* dst, const SampleFrame* src, float coeffSrcLeft, float coeffSrcRight, int frames )
 {
-
-	run<>( dst, src, frames, AddMultipliedStereoOp(coeffSrcLeft, coeffSrcRight) );
+	kernels().addMultipliedStereo(samples(dst), samples(src), coeffSrcLeft, coeffSrcRight, frames);
 }
 
 
@@ -317,7 +375,7 @@ struct MultiplyAndAddMultipliedOp
 
 void multiplyAndAddMultiplied( SampleFrame* dst, const SampleFrame* src, float coeffDst, float coeffSrc, int frames )
 {
-	run<>( dst, src, frames, MultiplyAndAddMultipliedOp(coeffDst, coeffSrc) );
+	kernels().multiplyAndAddMultiplied(samples(dst), samples(src), coeffDst, coeffSrc, frames);
 }
 
 
@@ -331,4 +389,3 @@ void multiplyAndAddMultipliedJoined( SampleFrame* dst,
 }
 
 } // namespace lmms::MixHelpers
-
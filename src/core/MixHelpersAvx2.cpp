@@ -0,0 +1,80 @@
+/*
+ * MixHelpersAvx2.cpp - AVX2 mixing kernels
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "MixHelpersKernels.h"
+
+#include <immintrin.h>
+
+namespace lmms::MixHelpers
+{
+
+namespace
+{
+
+struct Avx2
+{
+	using Vec = __m256;
+	static constexpr int Width = 8;
+
+	static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+	static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+	static Vec set1(float x) { return _mm256_set1_ps(x); }
+	static Vec setPairs(float l, float r) { return _mm256_setr_ps(l, r, l, r, l, r, l, r); }
+	//! c[0], c[0], c[1], c[1], ..., c[3], c[3]
+	static Vec loadDuplicated(const float* c)
+	{
+		const __m128 v = _mm_loadu_ps(c);
+		const __m256 lo = _mm256_castps128_ps256(_mm_unpacklo_ps(v, v));
+		return _mm256_insertf128_ps(lo, _mm_unpackhi_ps(v, v), 1);
+	}
+
+	static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+	static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+	static Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+	static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+	static Vec swapPairs(Vec v) { return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+	static Vec zeroNonFinite(Vec v)
+	{
+		const Vec zero = _mm256_setzero_ps();
+		return _mm256_and_ps(_mm256_cmp_ps(_mm256_mul_ps(v, zero), zero, _CMP_EQ_OQ), v);
+	}
+
+	static bool anyAbsNotLess(Vec v, Vec threshold)
+	{
+		const Vec abs = _mm256_andnot_ps(_mm256_set1_ps(-0.f), v);
+		return _mm256_movemask_ps(_mm256_cmp_ps(abs, threshold, _CMP_GE_OQ)) != 0;
+	}
+
+	static bool anyNonZero(Vec v)
+	{
+		return _mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_NEQ_UQ)) != 0;
+	}
+};
+
+} // namespace
+
+const Kernels avx2Kernels = makeKernels<Avx2>("AVX2");
+
+} // namespace lmms::MixHelpers
@@ -0,0 +1,78 @@
+/*
+ * MixHelpersAvx512.cpp - AVX-512 mixing kernels
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "MixHelpersKernels.h"
+
+#include <immintrin.h>
+
+namespace lmms::MixHelpers
+{
+
+namespace
+{
+
+struct Avx512
+{
+	using Vec = __m512;
+	static constexpr int Width = 16;
+
+	static Vec load(const float* p) { return _mm512_loadu_ps(p); }
+	static void store(float* p, Vec v) { _mm512_storeu_ps(p, v); }
+	static Vec set1(float x) { return _mm512_set1_ps(x); }
+	static Vec setPairs(float l, float r) { return _mm512_set_ps(r, l, r, l, r, l, r, l, r, l, r, l, r, l, r, l); }
+	//! c[0], c[0], c[1], c[1], ..., c[7], c[7]
+	static Vec loadDuplicated(const float* c)
+	{
+		const __m512i index = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+		return _mm512_permutexvar_ps(index, _mm512_castps256_ps512(_mm256_loadu_ps(c)));
+	}
+
+	static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+	static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+	static Vec min(Vec a, Vec b) { return _mm512_min_ps(a, b); }
+	static Vec max(Vec a, Vec b) { return _mm512_max_ps(a, b); }
+	static Vec swapPairs(Vec v) { return _mm512_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+	static Vec zeroNonFinite(Vec v)
+	{
+		const Vec zero = _mm512_setzero_ps();
+		return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(_mm512_mul_ps(v, zero), zero, _CMP_EQ_OQ), v);
+	}
+
+	static bool anyAbsNotLess(Vec v, Vec threshold)
+	{
+		return _mm512_cmp_ps_mask(_mm512_abs_ps(v), threshold, _CMP_GE_OQ) != 0;
+	}
+
+	static bool anyNonZero(Vec v)
+	{
+		return _mm512_cmp_ps_mask(v, _mm512_setzero_ps(), _CMP_NEQ_UQ) != 0;
+	}
+};
+
+} // namespace
+
+const Kernels avx512Kernels = makeKernels<Avx512>("AVX-512");
+
+} // namespace lmms::MixHelpers
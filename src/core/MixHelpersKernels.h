@@ -0,0 +1,332 @@
+/*
+ * MixHelpersKernels.h - mixing kernels, instantiated once per instruction set
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_MIX_HELPERS_KERNELS_H
+#define LMMS_MIX_HELPERS_KERNELS_H
+
+#include "lmmsconfig.h"
+
+namespace lmms::MixHelpers
+{
+
+//! The mixing kernels of one instruction set. Buffers are interleaved
+//! stereo, all sizes are in frames.
+struct Kernels
+{
+	const char* name;
+
+	void (*add)(float* dst, const float* src, int frames);
+	void (*multiply)(float* dst, float coeff, int frames);
+	void (*addMultiplied)(float* dst, const float* src, float coeffSrc, int frames);
+	void (*addSwappedMultiplied)(float* dst, const float* src, float coeffSrc, int frames);
+	void (*addMultipliedStereo)(float* dst, const float* src, float coeffSrcLeft, float coeffSrcRight, int frames);
+	void (*multiplyAndAddMultiplied)(float* dst, const float* src, float coeffDst, float coeffSrc, int frames);
+	void (*addMultipliedByBuffer)(float* dst, const float* src, float coeffSrc, const float* coeffSrcBuf, int frames);
+	void (*addMultipliedByBuffers)(float* dst, const float* src,
+		const float* coeffSrcBuf1, const float* coeffSrcBuf2, int frames);
+	void (*addSanitizedMultiplied)(float* dst, const float* src, float coeffSrc, int frames);
+	void (*addSanitizedMultipliedByBuffer)(float* dst, const float* src,
+		float coeffSrc, const float* coeffSrcBuf, int frames);
+	void (*addSanitizedMultipliedByBuffers)(float* dst, const float* src,
+		const float* coeffSrcBuf1, const float* coeffSrcBuf2, int frames);
+	bool (*isSilent)(const float* src, float threshold, int frames);
+	//! Clamps all samples to [-limit, limit], returns true if there was an inf or NaN instead
+	bool (*sanitize)(float* src, float limit, int frames);
+};
+
+extern const Kernels scalarKernels;
+#if defined(LMMS_HOST_X86) || defined(LMMS_HOST_X86_64)
+extern const Kernels sse2Kernels;
+extern const Kernels avx2Kernels;
+extern const Kernels avx512Kernels;
+#elif defined(LMMS_HOST_ARM64)
+extern const Kernels neonKernels;
+#endif
+
+
+// The kernels below are written against a small vector interface (V::load,
+// V::add, ...) and instantiated in one translation unit per instruction set,
+// which is compiled with the matching compiler flags. Everything here has
+// internal linkage and must not call into the standard library, so that no
+// code built for a wider instruction set can be picked by the linker for
+// callers in other translation units.
+namespace
+{
+
+//! Number of frames handled by one vector
+template<class V>
+constexpr int framesPerVector()
+{
+	return V::Width / 2;
+}
+
+template<class V>
+void add(float* dst, const float* src, int frames)
+{
+	const int n = frames * 2;
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		V::store(dst + i, V::add(V::load(dst + i), V::load(src + i)));
+	}
+	for (; i < n; ++i) { dst[i] += src[i]; }
+}
+
+template<class V>
+void multiply(float* dst, float coeff, int frames)
+{
+	const int n = frames * 2;
+	const auto c = V::set1(coeff);
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		V::store(dst + i, V::mul(V::load(dst + i), c));
+	}
+	for (; i < n; ++i) { dst[i] *= coeff; }
+}
+
+template<class V>
+void addMultiplied(float* dst, const float* src, float coeffSrc, int frames)
+{
+	const int n = frames * 2;
+	const auto c = V::set1(coeffSrc);
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		V::store(dst + i, V::add(V::load(dst + i), V::mul(V::load(src + i), c)));
+	}
+	for (; i < n; ++i) { dst[i] += src[i] * coeffSrc; }
+}
+
+template<class V>
+void addSwappedMultiplied(float* dst, const float* src, float coeffSrc, int frames)
+{
+	const auto c = V::set1(coeffSrc);
+	int f = 0;
+	for (; f + framesPerVector<V>() <= frames; f += framesPerVector<V>())
+	{
+		V::store(dst + 2 * f, V::add(V::load(dst + 2 * f), V::mul(V::swapPairs(V::load(src + 2 * f)), c)));
+	}
+	for (; f < frames; ++f)
+	{
+		dst[2 * f] += src[2 * f + 1] * coeffSrc;
+		dst[2 * f + 1] += src[2 * f] * coeffSrc;
+	}
+}
+
+template<class V>
+void addMultipliedStereo(float* dst, const float* src, float coeffSrcLeft, float coeffSrcRight, int frames)
+{
+	const auto c = V::setPairs(coeffSrcLeft, coeffSrcRight);
+	int f = 0;
+	for (; f + framesPerVector<V>() <= frames; f += framesPerVector<V>())
+	{
+		V::store(dst + 2 * f, V::add(V::load(dst + 2 * f), V::mul(V::load(src + 2 * f), c)));
+	}
+	for (; f < frames; ++f)
+	{
+		dst[2 * f] += src[2 * f] * coeffSrcLeft;
+		dst[2 * f + 1] += src[2 * f + 1] * coeffSrcRight;
+	}
+}
+
+template<class V>
+void multiplyAndAddMultiplied(float* dst, const float* src, float coeffDst, float coeffSrc, int frames)
+{
+	const int n = frames * 2;
+	const auto cd = V::set1(coeffDst);
+	const auto cs = V::set1(coeffSrc);
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		V::store(dst + i, V::add(V::mul(V::load(dst + i), cd), V::mul(V::load(src + i), cs)));
+	}
+	for (; i < n; ++i) { dst[i] = dst[i] * coeffDst + src[i] * coeffSrc; }
+}
+
+template<class V>
+void addMultipliedByBuffer(float* dst, const float* src, float coeffSrc, const float* coeffSrcBuf, int frames)
+{
+	const auto c = V::set1(coeffSrc);
+	int f = 0;
+	for (; f + framesPerVector<V>() <= frames; f += framesPerVector<V>())
+	{
+		const auto s = V::mul(V::mul(V::load(src + 2 * f), c), V::loadDuplicated(coeffSrcBuf + f));
+		V::store(dst + 2 * f, V::add(V::load(dst + 2 * f), s));
+	}
+	for (; f < frames; ++f)
+	{
+		dst[2 * f] += src[2 * f] * coeffSrc * coeffSrcBuf[f];
+		dst[2 * f + 1] += src[2 * f + 1] * coeffSrc * coeffSrcBuf[f];
+	}
+}
+
+template<class V>
+void addMultipliedByBuffers(float* dst, const float* src, const float* coeffSrcBuf1, const float* coeffSrcBuf2, int frames)
+{
+	int f = 0;
+	for (; f + framesPerVector<V>() <= frames; f += framesPerVector<V>())
+	{
+		const auto s = V::mul(V::mul(V::load(src + 2 * f), V::loadDuplicated(coeffSrcBuf1 + f)),
+			V::loadDuplicated(coeffSrcBuf2 + f));
+		V::store(dst + 2 * f, V::add(V::load(dst + 2 * f), s));
+	}
+	for (; f < frames; ++f)
+	{
+		dst[2 * f] += src[2 * f] * coeffSrcBuf1[f] * coeffSrcBuf2[f];
+		dst[2 * f + 1] += src[2 * f + 1] * coeffSrcBuf1[f] * coeffSrcBuf2[f];
+	}
+}
+
+//! x * 0 is 0 for finite values and NaN for infs and NaNs
+inline bool isFinite(float x)
+{
+	const float zero = x * 0.f;
+	return zero == 0.f;
+}
+
+template<class V>
+void addSanitizedMultiplied(float* dst, const float* src, float coeffSrc, int frames)
+{
+	const int n = frames * 2;
+	const auto c = V::set1(coeffSrc);
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		V::store(dst + i, V::add(V::load(dst + i), V::mul(V::zeroNonFinite(V::load(src + i)), c)));
+	}
+	for (; i < n; ++i) { dst[i] += isFinite(src[i]) ? src[i] * coeffSrc : 0.f; }
+}
+
+template<class V>
+void addSanitizedMultipliedByBuffer(float* dst, const float* src, float coeffSrc, const float* coeffSrcBuf, int frames)
+{
+	const auto c = V::set1(coeffSrc);
+	int f = 0;
+	for (; f + framesPerVector<V>() <= frames; f += framesPerVector<V>())
+	{
+		const auto s = V::mul(V::mul(V::zeroNonFinite(V::load(src + 2 * f)), c), V::loadDuplicated(coeffSrcBuf + f));
+		V::store(dst + 2 * f, V::add(V::load(dst + 2 * f), s));
+	}
+	for (; f < frames; ++f)
+	{
+		for (int ch = 0; ch < 2; ++ch)
+		{
+			const float s = src[2 * f + ch];
+			dst[2 * f + ch] += isFinite(s) ? s * coeffSrc * coeffSrcBuf[f] : 0.f;
+		}
+	}
+}
+
+template<class V>
+void addSanitizedMultipliedByBuffers(float* dst, const float* src,
+	const float* coeffSrcBuf1, const float* coeffSrcBuf2, int frames)
+{
+	int f = 0;
+	for (; f + framesPerVector<V>() <= frames; f += framesPerVector<V>())
+	{
+		const auto s = V::mul(V::mul(V::zeroNonFinite(V::load(src + 2 * f)), V::loadDuplicated(coeffSrcBuf1 + f)),
+			V::loadDuplicated(coeffSrcBuf2 + f));
+		V::store(dst + 2 * f, V::add(V::load(dst + 2 * f), s));
+	}
+	for (; f < frames; ++f)
+	{
+		for (int ch = 0; ch < 2; ++ch)
+		{
+			const float s = src[2 * f + ch];
+			dst[2 * f + ch] += isFinite(s) ? s * coeffSrcBuf1[f] * coeffSrcBuf2[f] : 0.f;
+		}
+	}
+}
+
+template<class V>
+bool isSilent(const float* src, float threshold, int frames)
+{
+	const int n = frames * 2;
+	const auto t = V::set1(threshold);
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		if (V::anyAbsNotLess(V::load(src + i), t)) { return false; }
+	}
+	for (; i < n; ++i)
+	{
+		const float a = src[i] < 0.f ? -src[i] : src[i];
+		if (a >= threshold) { return false; }
+	}
+	return true;
+}
+
+template<class V>
+bool sanitize(float* src, float limit, int frames)
+{
+	const int n = frames * 2;
+	const auto hi = V::set1(limit);
+	const auto lo = V::set1(-limit);
+	const auto zero = V::set1(0.f);
+
+	// Clamp everything and accumulate x * 0, which only stays 0 if all samples are finite
+	auto check = zero;
+	bool finite = true;
+	int i = 0;
+	for (; i + V::Width <= n; i += V::Width)
+	{
+		const auto v = V::load(src + i);
+		check = V::add(check, V::mul(v, zero));
+		V::store(src + i, V::min(V::max(v, lo), hi));
+	}
+	for (; i < n; ++i)
+	{
+		finite = finite && isFinite(src[i]);
+		src[i] = src[i] < -limit ? -limit : (src[i] > limit ? limit : src[i]);
+	}
+	return !finite || V::anyNonZero(check);
+}
+
+template<class V>
+constexpr Kernels makeKernels(const char* name)
+{
+	return Kernels{
+		name,
+		&add<V>,
+		&multiply<V>,
+		&addMultiplied<V>,
+		&addSwappedMultiplied<V>,
+		&addMultipliedStereo<V>,
+		&multiplyAndAddMultiplied<V>,
+		&addMultipliedByBuffer<V>,
+		&addMultipliedByBuffers<V>,
+		&addSanitizedMultiplied<V>,
+		&addSanitizedMultipliedByBuffer<V>,
+		&addSanitizedMultipliedByBuffers<V>,
+		&isSilent<V>,
+		&sanitize<V>
+	};
+}
+
+} // namespace
+
+} // namespace lmms::MixHelpers
+
+#endif // LMMS_MIX_HELPERS_KERNELS_H
@@ -0,0 +1,85 @@
+/*
+ * MixHelpersNeon.cpp - NEON mixing kernels
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "MixHelpersKernels.h"
+
+#include <arm_neon.h>
+
+namespace lmms::MixHelpers
+{
+
+namespace
+{
+
+struct Neon
+{
+	using Vec = float32x4_t;
+	static constexpr int Width = 4;
+
+	static Vec load(const float* p) { return vld1q_f32(p); }
+	static void store(float* p, Vec v) { vst1q_f32(p, v); }
+	static Vec set1(float x) { return vdupq_n_f32(x); }
+	static Vec setPairs(float l, float r)
+	{
+		const float32x2_t pair = vset_lane_f32(r, vdup_n_f32(l), 1);
+		return vcombine_f32(pair, pair);
+	}
+	//! c[0], c[0], c[1], c[1]
+	static Vec loadDuplicated(const float* c)
+	{
+		const float32x2_t v = vld1_f32(c);
+		const float32x2x2_t zipped = vzip_f32(v, v);
+		return vcombine_f32(zipped.val[0], zipped.val[1]);
+	}
+
+	static Vec add(Vec a, Vec b) { return vaddq_f32(a, b); }
+	static Vec mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+	static Vec min(Vec a, Vec b) { return vminq_f32(a, b); }
+	static Vec max(Vec a, Vec b) { return vmaxq_f32(a, b); }
+	static Vec swapPairs(Vec v) { return vrev64q_f32(v); }
+
+	static Vec zeroNonFinite(Vec v)
+	{
+		const Vec zero = vdupq_n_f32(0.f);
+		const uint32x4_t finite = vceqq_f32(vmulq_f32(v, zero), zero);
+		return vreinterpretq_f32_u32(vandq_u32(finite, vreinterpretq_u32_f32(v)));
+	}
+
+	static bool anyAbsNotLess(Vec v, Vec threshold)
+	{
+		return vmaxvq_u32(vcgeq_f32(vabsq_f32(v), threshold)) != 0;
+	}
+
+	static bool anyNonZero(Vec v)
+	{
+		// NaN compares unequal to everything
+		return vminvq_u32(vceqq_f32(v, vdupq_n_f32(0.f))) == 0;
+	}
+};
+
+} // namespace
+
+const Kernels neonKernels = makeKernels<Neon>("NEON");
+
+} // namespace lmms::MixHelpers
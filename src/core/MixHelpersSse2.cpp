@@ -0,0 +1,79 @@
+/*
+ * MixHelpersSse2.cpp - SSE2 mixing kernels
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "MixHelpersKernels.h"
+
+#include <emmintrin.h>
+
+namespace lmms::MixHelpers
+{
+
+namespace
+{
+
+struct Sse2
+{
+	using Vec = __m128;
+	static constexpr int Width = 4;
+
+	static Vec load(const float* p) { return _mm_loadu_ps(p); }
+	static void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+	static Vec set1(float x) { return _mm_set1_ps(x); }
+	static Vec setPairs(float l, float r) { return _mm_setr_ps(l, r, l, r); }
+	//! c[0], c[0], c[1], c[1]
+	static Vec loadDuplicated(const float* c)
+	{
+		const Vec v = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(c)));
+		return _mm_unpacklo_ps(v, v);
+	}
+
+	static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+	static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+	static Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+	static Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+	static Vec swapPairs(Vec v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+	static Vec zeroNonFinite(Vec v)
+	{
+		const Vec zero = _mm_setzero_ps();
+		return _mm_and_ps(_mm_cmpeq_ps(_mm_mul_ps(v, zero), zero), v);
+	}
+
+	static bool anyAbsNotLess(Vec v, Vec threshold)
+	{
+		const Vec abs = _mm_andnot_ps(_mm_set1_ps(-0.f), v);
+		return _mm_movemask_ps(_mm_cmpge_ps(abs, threshold)) != 0;
+	}
+
+	static bool anyNonZero(Vec v)
+	{
+		return _mm_movemask_ps(_mm_cmpneq_ps(v, _mm_setzero_ps())) != 0;
+	}
+};
+
+} // namespace
+
+const Kernels sse2Kernels = makeKernels<Sse2>("SSE2");
+
+} // namespace lmms::MixHelpers
@@ -26,6 +26,7 @@
 
 #include "AudioEngine.h"
 #include "AudioEngineWorkerThread.h"
+#include "AudioPort.h"
 #include "BufferManager.h"
 #include "Mixer.h"
 #include "MixHelpers.h"
@@ -69,7 +70,6 @@ MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_soloModel( false, _parent ),
 	m_volumeModel(1.f, 0.f, 2.f, 0.001f, _parent),
 	m_name(),
-	m_lock(),
 	m_channelIndex( idx ),
 	m_queued( false ),
 	m_dependenciesMet(0)
@@ -121,6 +121,14 @@ void MixerChannel::doProcessing()
 
 	if( m_muted == false )
 	{
+		// pull the output of the audio ports feeding this channel, so the
+		// ports do not need to synchronize when writing into our buffer
+		for( const SampleFrame* input : m_inputs )
+		{
+			MixHelpers::add( m_buffer, input, fpp );
+			m_hasInput = true;
+		}
+
 		for( MixerRoute * senderRoute : m_receives )
 		{
 			MixerChannel * sender = senderRoute->sender();
@@ -190,6 +198,7 @@ Mixer::Mixer() :
 	Model( nullptr ),
 	JournallingObject(),
 	m_mixerChannels(),
+	m_criticalPathLength(0),
 	m_lastSoloed(-1)
 {
 	// create master channel
@@ -223,6 +232,10 @@ int Mixer::createChannel()
 	// reset channel state
 	clearChannel( index );
 
+	Engine::audioEngine()->requestChangeInModel();
+	rebuildSchedule();
+	Engine::audioEngine()->doneChangeInModel();
+
 	// if there is a soloed channel, mute the new track
 	if (m_lastSoloed != -1 && m_mixerChannels[m_lastSoloed]->m_soloModel.value())
 	{
@@ -373,11 +386,51 @@ void Mixer::deleteChannel( int index )
 		}
 	}
 
+	rebuildSchedule();
+
 	Engine::audioEngine()->doneChangeInModel();
 }
 
 
 
+void Mixer::rebuildSchedule()
+{
+	const auto count = m_mixerChannels.size();
+
+	// Kahn's algorithm - a channel gets scheduled once all of its senders are
+	std::vector<std::size_t> pendingSenders(count);
+	// number of channels on the longest send chain ending in each channel
+	std::vector<int> chainLength(count, 1);
+
+	m_schedule.clear();
+	m_schedule.reserve(count);
+	for (MixerChannel* ch : m_mixerChannels)
+	{
+		pendingSenders[ch->m_channelIndex] = ch->m_receives.size();
+		if (ch->m_receives.empty()) { m_schedule.push_back(ch); }
+	}
+
+	int criticalPath = 0;
+	for (std::size_t i = 0; i < m_schedule.size(); ++i)
+	{
+		const MixerChannel* ch = m_schedule[i];
+		const int length = chainLength[ch->m_channelIndex];
+		criticalPath = std::max(criticalPath, length);
+
+		for (const MixerRoute* send : ch->m_sends)
+		{
+			const auto receiver = send->receiverIndex();
+			chainLength[receiver] = std::max(chainLength[receiver], length + 1);
+			if (--pendingSenders[receiver] == 0) { m_schedule.push_back(send->receiver()); }
+		}
+	}
+
+	m_criticalPathLength = criticalPath;
+	Engine::audioEngine()->profiler().setMixerCriticalPath(criticalPath);
+}
+
+
+
 void Mixer::moveChannelLeft( int index )
 {
 	// can't move master or first channel
@@ -485,7 +538,8 @@ MixerRoute * Mixer::createRoute( MixerChannel * from, MixerChannel * to, float a
 	to->m_receives.push_back(route);
 
 	// add us to mixer's list
-	Engine::mixer()->m_mixerRoutes.push_back(route);
+	m_mixerRoutes.push_back(route);
+	rebuildSchedule();
 	Engine::audioEngine()->doneChangeInModel();
 
 	return route;
@@ -528,9 +582,10 @@ void Mixer::deleteChannelSend( MixerRoute * route )
 	removeFromMixerRoute(route->receiver()->m_receives);
 
 	// remove us from mixer's list
-	removeFromMixerRoute(Engine::mixer()->m_mixerRoutes);
+	removeFromMixerRoute(m_mixerRoutes);
 
 	delete route;
+	rebuildSchedule();
 	Engine::audioEngine()->doneChangeInModel();
 }
 
@@ -596,20 +651,6 @@ FloatModel * Mixer::channelSendModel( mix_ch_t fromChannel, mix_ch_t toChannel )
 
 
 
-void Mixer::mixToChannel( const SampleFrame* _buf, mix_ch_t _ch )
-{
-	if( m_mixerChannels[_ch]->m_muteModel.value() == false )
-	{
-		m_mixerChannels[_ch]->m_lock.lock();
-		MixHelpers::add( m_mixerChannels[_ch]->m_buffer, _buf, Engine::audioEngine()->framesPerPeriod() );
-		m_mixerChannels[_ch]->m_hasInput = true;
-		m_mixerChannels[_ch]->m_lock.unlock();
-	}
-}
-
-
-
-
 void Mixer::prepareMasterMix()
 {
 	BufferManager::clear( m_mixerChannels[0]->m_buffer,
@@ -622,47 +663,45 @@ void Mixer::masterMix( SampleFrame* _buf )
 {
 	const int fpp = Engine::audioEngine()->framesPerPeriod();
 
-	// add the channels that have no dependencies (no incoming senders, ie.
-	// no receives) to the jobqueue. The channels that have receives get
-	// added when their senders get processed, which is detected by
-	// dependency counting.
-	// also instantly add all muted channels as they don't need to care
-	// about their senders, and can just increment the deps of their
-	// recipients right away.
-	AudioEngineWorkerThread::resetJobQueue( AudioEngineWorkerThread::JobQueue::OperationMode::Dynamic );
+	// the mute state has to be known for all channels before any of them
+	// reports to its receivers
 	for( MixerChannel * ch : m_mixerChannels )
 	{
 		ch->m_muted = ch->m_muteModel.value();
-		if( ch->m_muted ) // instantly "process" muted channels
-		{
-			ch->processed();
-			ch->done();
-		}
-		else if( ch->m_receives.size() == 0 )
+		ch->m_inputs.clear();
+	}
+
+	for( AudioPort * port : Engine::audioEngine()->audioPorts() )
+	{
+		const mix_ch_t channel = port->nextMixerChannel();
+		if( port->hasOutput() && channel < numChannels() )
 		{
-			ch->m_queued = true;
-			AudioEngineWorkerThread::addJob( ch );
+			m_mixerChannels[channel]->m_inputs.push_back( port->buffer() );
 		}
 	}
-	while (m_mixerChannels[0]->state() != ThreadableJob::ProcessingState::Done)
+
+	// walk the precomputed schedule: add the channels that have no
+	// dependencies (no incoming senders, ie. no receives) to the jobqueue and
+	// instantly "process" muted channels, as they don't need to care about
+	// their senders and can just increment the deps of their recipients.
+	// Every other channel is added to the jobqueue by the worker that
+	// processes its last sender, so the whole mixer graph is done in a single
+	// run of the workers.
+	AudioEngineWorkerThread::resetJobQueue( AudioEngineWorkerThread::JobQueue::OperationMode::Dynamic );
+	for( MixerChannel * ch : m_schedule )
 	{
-		bool found = false;
-		for( MixerChannel * ch : m_mixerChannels )
+		if( ch->m_muted )
 		{
-			const auto s = ch->state();
-			if (s == ThreadableJob::ProcessingState::Queued
-				|| s == ThreadableJob::ProcessingState::InProgress)
-			{
-				found = true;
-				break;
-			}
+			ch->processed();
+			ch->done();
 		}
-		if( !found )
+		else if( ch->m_receives.empty() )
 		{
-			break;
+			ch->m_queued = true;
+			AudioEngineWorkerThread::addJob( ch );
 		}
-		AudioEngineWorkerThread::startAndWaitForJobs();
 	}
+	AudioEngineWorkerThread::startAndWaitForJobs();
 
 	// handle sample-exact data in master volume fader
 	ValueBuffer * volBuf = m_mixerChannels[0]->m_volumeModel.valueBuffer();
@@ -25,6 +25,9 @@
 
 #include "NotePlayHandle.h"
 
+#include <algorithm>
+#include <cstddef>
+
 #include "AudioEngine.h"
 #include "BasicFilters.h"
 #include "DetuningHelper.h"
@@ -602,25 +605,50 @@ void NotePlayHandle::resize( const bpm_t _new_tempo )
 }
 
 
-NotePlayHandle ** NotePlayHandleManager::s_available;
-QReadWriteLock NotePlayHandleManager::s_mutex;
-std::atomic_int NotePlayHandleManager::s_availableIndex;
-int NotePlayHandleManager::s_size;
+struct NotePlayHandleManager::Slot
+{
+	//! Marks slots allocated on their own because all segments are in use
+	static constexpr std::uint32_t NoIndex = ~std::uint32_t{0};
 
+	std::atomic<std::uint32_t> next; // index + 1 of the next free slot, 0 for none
+	std::uint32_t index;
+	alignas(NotePlayHandle) std::byte storage[sizeof(NotePlayHandle)];
 
-void NotePlayHandleManager::init()
+	NotePlayHandle * handle()
+	{
+		return reinterpret_cast<NotePlayHandle*>(storage);
+	}
+
+	static Slot * fromHandle( NotePlayHandle * nph )
+	{
+		return reinterpret_cast<Slot*>(reinterpret_cast<std::byte*>(nph) - offsetof(Slot, storage));
+	}
+};
+
+
+struct NotePlayHandleManager::Segment
+{
+	Slot slots[NPH_SEGMENT_SIZE];
+};
+
+
+std::atomic<NotePlayHandleManager::Segment*> NotePlayHandleManager::s_segments[MAX_NPH_SEGMENTS];
+std::atomic<std::uint32_t> NotePlayHandleManager::s_segmentCount;
+std::atomic<std::uint64_t> NotePlayHandleManager::s_freeHead;
+
+
+static std::uint64_t taggedHead( std::uint64_t oldHead, std::uint32_t index )
 {
-	s_available = new NotePlayHandle*[INITIAL_NPH_CACHE];
+	return ( ( oldHead >> 32 ) + 1 ) << 32 | ( index + 1 );
+}
 
-	auto n = static_cast<NotePlayHandle *>(std::malloc(sizeof(NotePlayHandle) * INITIAL_NPH_CACHE));
 
-	for( int i=0; i < INITIAL_NPH_CACHE; ++i )
+void NotePlayHandleManager::init()
+{
+	while( capacity() < INITIAL_NPH_CACHE )
 	{
-		s_available[ i ] = n;
-		++n;
+		push( addSegment() );
 	}
-	s_availableIndex = INITIAL_NPH_CACHE - 1;
-	s_size = INITIAL_NPH_CACHE;
 }
 
 
@@ -632,45 +660,125 @@ NotePlayHandle * NotePlayHandleManager::acquire( InstrumentTrack* instrumentTrac
 				int midiEventChannel,
 				NotePlayHandle::Origin origin )
 {
-	// TODO: use some lockless data structures
-	s_mutex.lockForWrite();
-	if (s_availableIndex < 0) { extend(NPH_CACHE_INCREMENT); }
-	NotePlayHandle * nph = s_available[s_availableIndex--];
-	s_mutex.unlock();
+	Slot * slot = pop();
+	if( slot == nullptr )
+	{
+		if( Engine::audioEngine() )
+		{
+			Engine::audioEngine()->profiler().recordPoolMiss( AudioEngineProfiler::PoolType::NotePlayHandles );
+		}
+		slot = addSegment();
+	}
 
-	new( (void*)nph ) NotePlayHandle( instrumentTrack, offset, frames, noteToPlay, parent, midiEventChannel, origin );
-	return nph;
+	return new( slot->storage ) NotePlayHandle( instrumentTrack, offset, frames, noteToPlay, parent, midiEventChannel, origin );
 }
 
 
 void NotePlayHandleManager::release( NotePlayHandle * nph )
 {
 	nph->NotePlayHandle::~NotePlayHandle();
-	s_mutex.lockForRead();
-	s_available[++s_availableIndex] = nph;
-	s_mutex.unlock();
+
+	Slot * slot = Slot::fromHandle( nph );
+	if( slot->index == Slot::NoIndex )
+	{
+		delete slot;
+		return;
+	}
+	push( slot );
 }
 
 
-void NotePlayHandleManager::extend( int c )
+void NotePlayHandleManager::free()
 {
-	s_size += c;
-	auto tmp = new NotePlayHandle*[s_size];
-	delete[] s_available;
-	s_available = tmp;
+	s_freeHead = 0;
+	const auto count = std::min<std::uint32_t>( s_segmentCount.exchange( 0 ), MAX_NPH_SEGMENTS );
+	for( std::uint32_t i = 0; i < count; ++i )
+	{
+		delete s_segments[i].exchange( nullptr );
+	}
+}
 
-	auto n = static_cast<NotePlayHandle *>(std::malloc(sizeof(NotePlayHandle) * c));
 
-	for( int i=0; i < c; ++i )
+NotePlayHandleManager::Slot * NotePlayHandleManager::pop()
+{
+	auto head = s_freeHead.load( std::memory_order_acquire );
+	while( true )
 	{
-		s_available[++s_availableIndex] = n;
-		++n;
+		const auto top = static_cast<std::uint32_t>( head );
+		if( top == 0 )
+		{
+			return nullptr;
+		}
+
+		// the tag makes the exchange fail if the slot was popped and pushed
+		// again by another thread in the meantime
+		Slot * slot = slotAt( top - 1 );
+		const auto next = slot->next.load( std::memory_order_relaxed );
+		if( s_freeHead.compare_exchange_weak( head, ( ( head >> 32 ) + 1 ) << 32 | next,
+				std::memory_order_acq_rel, std::memory_order_acquire ) )
+		{
+			return slot;
+		}
 	}
 }
 
-void NotePlayHandleManager::free()
+
+void NotePlayHandleManager::push( Slot * slot )
 {
-	delete[] s_available;
+	auto head = s_freeHead.load( std::memory_order_relaxed );
+	do
+	{
+		slot->next.store( static_cast<std::uint32_t>( head ), std::memory_order_relaxed );
+	}
+	while( !s_freeHead.compare_exchange_weak( head, taggedHead( head, slot->index ),
+			std::memory_order_release, std::memory_order_relaxed ) );
+}
+
+
+NotePlayHandleManager::Slot * NotePlayHandleManager::slotAt( std::uint32_t index )
+{
+	Segment * segment = s_segments[index / NPH_SEGMENT_SIZE].load( std::memory_order_acquire );
+	return &segment->slots[index % NPH_SEGMENT_SIZE];
+}
+
+
+NotePlayHandleManager::Slot * NotePlayHandleManager::addSegment()
+{
+	auto count = s_segmentCount.load();
+	do
+	{
+		if( count >= MAX_NPH_SEGMENTS )
+		{
+			// should never happen in practice - hand out a single slot
+			// which gets deleted again on release
+			auto slot = new Slot;
+			slot->index = Slot::NoIndex;
+			return slot;
+		}
+	}
+	while( !s_segmentCount.compare_exchange_weak( count, count + 1 ) );
+
+	auto segment = new Segment;
+	for( std::uint32_t i = 0; i < NPH_SEGMENT_SIZE; ++i )
+	{
+		segment->slots[i].index = count * NPH_SEGMENT_SIZE + i;
+		segment->slots[i].next.store( segment->slots[i].index + 2, std::memory_order_relaxed );
+	}
+	s_segments[count].store( segment, std::memory_order_release );
+
+	// keep the first slot for the caller and splice all others into the
+	// free list at once
+	Slot & first = segment->slots[1];
+	Slot & last = segment->slots[NPH_SEGMENT_SIZE - 1];
+	auto head = s_freeHead.load( std::memory_order_relaxed );
+	do
+	{
+		last.next.store( static_cast<std::uint32_t>( head ), std::memory_order_relaxed );
+	}
+	while( !s_freeHead.compare_exchange_weak( head, taggedHead( head, first.index ),
+			std::memory_order_release, std::memory_order_relaxed ) );
+
+	return &segment->slots[0];
 }
 
 
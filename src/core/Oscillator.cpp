@@ -26,26 +26,86 @@
 #include "Oscillator.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #if !defined(__MINGW32__) && !defined(__MINGW64__)
 	#include <thread>
 #endif
 
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
 #include "BufferManager.h"
+#include "ConfigManager.h"
 #include "Engine.h"
 #include "AudioEngine.h"
 #include "AutomatableModel.h"
 #include "fftw3.h"
 #include "fft_helpers.h"
+#include "lmmsversion.h"
 
 
 namespace lmms
 {
 
 
+namespace
+{
+
+//! Increase whenever the wave table generation changes
+constexpr std::uint32_t WaveTableCacheVersion = 1;
+
+//! Precedes the tables in the cache file. 64 bytes, so the tables stay aligned.
+struct WaveTableCacheHeader
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t shapes;
+	std::uint32_t tablesPerShape;
+	std::uint32_t tableLength;
+	std::uint32_t sampleSize;
+	char lmmsVersion[36];
+};
+static_assert(sizeof(WaveTableCacheHeader) == 64);
+
+const WaveTableCacheHeader& expectedWaveTableCacheHeader()
+{
+	static const WaveTableCacheHeader header = []
+	{
+		WaveTableCacheHeader h{};
+		std::memcpy(h.magic, "LMMSWTC", 8);
+		h.version = WaveTableCacheVersion;
+		h.shapes = Oscillator::NumWaveShapeTables;
+		h.tablesPerShape = OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT;
+		h.tableLength = OscillatorConstants::WAVETABLE_LENGTH;
+		h.sampleSize = sizeof(sample_t);
+		std::strncpy(h.lmmsVersion, LMMS_VERSION, sizeof(h.lmmsVersion) - 1);
+		return h;
+	}();
+	return header;
+}
+
+QString waveTableCacheFile()
+{
+	return ConfigManager::inst()->cacheDir() + "wavetables.bin";
+}
+
+//! Keeps the mapping of the cache file alive
+std::unique_ptr<QFile> s_waveTableFile;
+
+} // namespace
+
+
 void Oscillator::waveTableInit()
 {
 	createFFTPlans();
-	generateWaveTables();
+	if (!loadWaveTables())
+	{
+		generateWaveTables();
+		saveWaveTables();
+	}
 	// The oscillator FFT plans remain throughout the application lifecycle
 	// due to being expensive to create, and being used whenever a userwave form is changed
 	// deleted in main.cpp main()
@@ -203,10 +263,13 @@ std::unique_ptr<OscillatorConstants::waveform_t> Oscillator::generateAntiAliasUs
 
 
 
-sample_t Oscillator::s_waveTables
+sample_t Oscillator::s_waveTableStorage
 	[Oscillator::NumWaveShapeTables]
 	[OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT]
 	[OscillatorConstants::WAVETABLE_LENGTH];
+const sample_t (*Oscillator::s_waveTables)
+	[OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT]
+	[OscillatorConstants::WAVETABLE_LENGTH] = Oscillator::s_waveTableStorage;
 fftwf_plan Oscillator::s_fftPlan;
 fftwf_plan Oscillator::s_ifftPlan;
 fftwf_complex * Oscillator::s_specBuf;
@@ -247,21 +310,21 @@ void Oscillator::generateWaveTables()
 
 		// Clear the first wave table
 		std::fill(
-		    std::begin(s_waveTables[shapeID][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT - 1]),
-		    std::end(s_waveTables[shapeID][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT - 1]),
+		    std::begin(s_waveTableStorage[shapeID][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT - 1]),
+		    std::end(s_waveTableStorage[shapeID][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT - 1]),
 		    0.f);
 
 		for (int i = OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT - 1; i >= 0; i--)
 		{
 			const int bands = OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i);
-			generator(bands, s_waveTables[shapeID][i], lastBands + 1);
+			generator(bands, s_waveTableStorage[shapeID][i], lastBands + 1);
 			lastBands = bands;
 			if (i)
 			{
 				std::copy(
-					s_waveTables[shapeID][i],
-					s_waveTables[shapeID][i] + OscillatorConstants::WAVETABLE_LENGTH,
-					s_waveTables[shapeID][i - 1]);
+					s_waveTableStorage[shapeID][i],
+					s_waveTableStorage[shapeID][i] + OscillatorConstants::WAVETABLE_LENGTH,
+					s_waveTableStorage[shapeID][i - 1]);
 			}
 		}
 	};
@@ -278,7 +341,7 @@ void Oscillator::generateWaveTables()
 				Oscillator::s_sampleBuffer[i] = moogSawSample((float)i / (float)OscillatorConstants::WAVETABLE_LENGTH);
 			}
 			fftwf_execute(s_fftPlan);
-			generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), s_waveTables[static_cast<std::size_t>(WaveShape::MoogSaw) - FirstWaveShapeTable][i]);
+			generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), s_waveTableStorage[static_cast<std::size_t>(WaveShape::MoogSaw) - FirstWaveShapeTable][i]);
 		}
 
 		// Generate exponential tables
@@ -289,7 +352,7 @@ void Oscillator::generateWaveTables()
 				s_sampleBuffer[i] = expSample((float)i / (float)OscillatorConstants::WAVETABLE_LENGTH);
 			}
 			fftwf_execute(s_fftPlan);
-			generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), s_waveTables[static_cast<std::size_t>(WaveShape::Exponential) - FirstWaveShapeTable][i]);
+			generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), s_waveTableStorage[static_cast<std::size_t>(WaveShape::Exponential) - FirstWaveShapeTable][i]);
 		}
 	};
 
@@ -316,6 +379,51 @@ void Oscillator::generateWaveTables()
 
 
 
+bool Oscillator::loadWaveTables()
+{
+	auto file = std::make_unique<QFile>(waveTableCacheFile());
+	if (!file->open(QIODevice::ReadOnly) || file->size() != sizeof(WaveTableCacheHeader) + sizeof(s_waveTableStorage))
+	{
+		return false;
+	}
+
+	WaveTableCacheHeader header;
+	if (file->read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)
+		|| std::memcmp(&header, &expectedWaveTableCacheHeader(), sizeof(header)) != 0)
+	{
+		return false;
+	}
+
+	// The tables are never written after generation, so they can stay in the
+	// page cache and be shared between LMMS processes
+	const uchar* tables = file->map(sizeof(header), sizeof(s_waveTableStorage));
+	if (!tables) { return false; }
+
+	s_waveTables = reinterpret_cast<decltype(s_waveTables)>(tables);
+	s_waveTableFile = std::move(file);
+	return true;
+}
+
+
+
+
+void Oscillator::saveWaveTables()
+{
+	const QString fileName = waveTableCacheFile();
+	QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+	QSaveFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly)) { return; }
+
+	const WaveTableCacheHeader& header = expectedWaveTableCacheHeader();
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(s_waveTableStorage), sizeof(s_waveTableStorage));
+	file.commit();
+}
+
+
+
+
 void Oscillator::updateNoSub( SampleFrame* _ab, const fpp_t _frames,
 							const ch_cnt_t _chnl )
 {
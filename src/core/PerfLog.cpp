@@ -135,5 +135,34 @@ void PerfLogTimer::end()
 	begin_time = PerfTime();
 }
 
+PerfLogAccumulator::PerfLogAccumulator(const QString& name)
+	: m_name(name)
+	, m_total(0)
+	, m_intervals(0)
+	, m_ended(false)
+{
+}
+
+PerfLogAccumulator::~PerfLogAccumulator()
+{
+	end();
+}
+
+void PerfLogAccumulator::end()
+{
+	if (m_ended) {
+		return;
+	}
+
+	using Seconds = std::chrono::duration<double>;
+	const auto total = std::chrono::duration_cast<Seconds>(Clock::duration(m_total.load()));
+	qWarning("PERFLOG | %20s | %.2felapsed in %ld intervals",
+			 qPrintable(m_name),
+			 total.count(),
+			 m_intervals.load());
+
+	m_ended = true;
+}
+
 
 } // namespace lmms
\ No newline at end of file
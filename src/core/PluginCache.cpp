@@ -0,0 +1,175 @@
+/*
+ * PluginCache.cpp - on-disk cache of plugin scan results
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "PluginCache.h"
+
+#include <algorithm>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "ConfigManager.h"
+
+namespace lmms
+{
+
+
+namespace
+{
+
+constexpr quint32 CacheMagic = 0x4c504331; // "LPC1"
+constexpr quint32 CacheVersion = 1;
+
+qint64 modificationTime(const QFileInfo& file, qint64 dataModified)
+{
+	return std::max(file.lastModified().toMSecsSinceEpoch(), dataModified);
+}
+
+} // namespace
+
+
+bool PluginCache::s_rescan = false;
+
+
+PluginCache::PluginCache(const QString& name, const QString& context) :
+	m_fileName(ConfigManager::inst()->cacheDir() + name + ".cache"),
+	m_context(context)
+{
+	if (!s_rescan) { load(); }
+}
+
+
+
+
+PluginCache::~PluginCache()
+{
+	// also rewrite the file if entries for removed libraries were dropped
+	if (m_modified || m_used.size() != m_entries.size())
+	{
+		save();
+	}
+}
+
+
+
+
+bool PluginCache::lookup(const QFileInfo& file, QVariantMap& data, qint64 dataModified)
+{
+	const QString path = file.absoluteFilePath();
+	const auto it = m_entries.constFind(path);
+	if (it == m_entries.constEnd()
+		|| it->size != file.size()
+		|| it->modified != modificationTime(file, dataModified))
+	{
+		return false;
+	}
+
+	m_used.insert(path);
+	data = it->data;
+	return true;
+}
+
+
+
+
+void PluginCache::insert(const QFileInfo& file, const QVariantMap& data, qint64 dataModified)
+{
+	const QString path = file.absoluteFilePath();
+	const Entry entry{file.size(), modificationTime(file, dataModified), data};
+	m_used.insert(path);
+
+	const auto it = m_entries.find(path);
+	if (it != m_entries.end() && it->size == entry.size
+		&& it->modified == entry.modified && it->data == entry.data)
+	{
+		return;
+	}
+	m_entries.insert(path, entry);
+	m_modified = true;
+}
+
+
+
+
+void PluginCache::load()
+{
+	QFile file(m_fileName);
+	if (!file.open(QIODevice::ReadOnly)) { return; }
+
+	QDataStream in(&file);
+	in.setVersion(QDataStream::Qt_5_9);
+
+	quint32 magic = 0, version = 0;
+	QString context;
+	in >> magic >> version >> context;
+	if (magic != CacheMagic || version != CacheVersion || context != m_context)
+	{
+		return;
+	}
+
+	quint32 count = 0;
+	in >> count;
+	for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i)
+	{
+		QString path;
+		Entry entry;
+		in >> path >> entry.size >> entry.modified >> entry.data;
+		m_entries.insert(path, entry);
+	}
+
+	// a truncated file is as good as none
+	if (in.status() != QDataStream::Ok) { m_entries.clear(); }
+}
+
+
+
+
+void PluginCache::save() const
+{
+	if (!QDir().mkpath(QFileInfo(m_fileName).absolutePath())) { return; }
+
+	QSaveFile file(m_fileName);
+	if (!file.open(QIODevice::WriteOnly)) { return; }
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_5_9);
+	out << CacheMagic << CacheVersion << m_context
+		<< static_cast<quint32>(m_used.size());
+	for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+	{
+		if (!m_used.contains(it.key())) { continue; }
+		out << it.key() << it->size << it->modified << it->data;
+	}
+
+	if (!file.commit())
+	{
+		qWarning("Could not write plugin cache %s", qUtf8Printable(m_fileName));
+	}
+}
+
+
+} // namespace lmms
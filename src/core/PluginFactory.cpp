@@ -33,6 +33,7 @@
 
 #include "ConfigManager.h"
 #include "Plugin.h"
+#include "PluginCache.h"
 
 // QT qHash specialization, needs to be in global namespace
 qint64 qHash(const QFileInfo& fi)
@@ -158,18 +159,43 @@ void PluginFactory::discoverPlugins()
 	}
 
 	// Cheap dependency handling: zynaddsubfx needs ZynAddSubFxCore. By loading
-	// all libraries twice we ensure that libZynAddSubFxCore is found.
+	// all libraries twice we ensure that libZynAddSubFxCore is found. If the
+	// cache knows all libraries, it is enough to load the ones without a
+	// plugin descriptor first.
+	PluginCache cache("plugins");
+	QList<QFileInfo> dependencies, plugins;
+	bool allCached = true;
 	for (const QFileInfo& file : files)
 	{
-		QLibrary(file.absoluteFilePath()).load();
+		QVariantMap entry;
+		if (!cache.lookup(file, entry)) { allCached = false; }
+		(entry.value("plugin", true).toBool() ? plugins : dependencies) << file;
 	}
 
-	for (const QFileInfo& file : files)
+	if (allCached)
+	{
+		for (const QFileInfo& file : dependencies)
+		{
+			QLibrary(file.absoluteFilePath()).load();
+		}
+	}
+	else
+	{
+		for (const QFileInfo& file : files)
+		{
+			QLibrary(file.absoluteFilePath()).load();
+		}
+		plugins = files.values();
+	}
+
+	for (const QFileInfo& file : plugins)
 	{
 		auto library = std::make_shared<QLibrary>(file.absoluteFilePath());
 		if (! library->load()) {
 			m_errors[file.baseName()] = library->errorString();
 			qWarning("%s", library->errorString().toLocal8Bit().data());
+			// try again next time, but without the extra loading pass
+			cache.insert(file, {{"plugin", true}});
 			continue;
 		}
 
@@ -187,9 +213,11 @@ void PluginFactory::discoverPlugins()
 			{
 				qWarning() << qApp->translate("PluginFactory", "LMMS plugin %1 does not have a plugin descriptor named %2!").
 							  arg(file.absoluteFilePath()).arg(descriptorName);
+				cache.insert(file, {{"plugin", false}});
 				continue;
 			}
 		}
+		cache.insert(file, {{"plugin", pluginDescriptor != nullptr}});
 
 		if(pluginDescriptor)
 		{
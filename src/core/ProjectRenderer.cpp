@@ -26,6 +26,8 @@
 #include <QFile>
 
 #include "ProjectRenderer.h"
+#include "AudioEncoderThread.h"
+#include "AudioPort.h"
 #include "Song.h"
 #include "PerfLog.h"
 
@@ -84,25 +86,55 @@ ProjectRenderer::ProjectRenderer( const AudioEngine::qualitySettings & qualitySe
 					const QString & outputFilename ) :
 	QThread( Engine::audioEngine() ),
 	m_fileDev( nullptr ),
+	m_outputSettings( outputSettings ),
+	m_fileFormat( exportFileFormat ),
 	m_qualitySettings( qualitySettings ),
 	m_progress( 0 ),
 	m_abort( false )
 {
-	AudioFileDeviceInstantiaton audioEncoderFactory = fileEncodeDevices[static_cast<std::size_t>(exportFileFormat)].m_getDevInst;
+	m_fileDev = createFileDevice( outputFilename );
+}
+
+
+
+
+ProjectRenderer::~ProjectRenderer() = default;
+
+
+
+
+AudioFileDevice * ProjectRenderer::createFileDevice( const QString & outputFilename ) const
+{
+	AudioFileDeviceInstantiaton audioEncoderFactory = fileEncodeDevices[static_cast<std::size_t>(m_fileFormat)].m_getDevInst;
 
 	if (audioEncoderFactory)
 	{
 		bool successful = false;
 
-		m_fileDev = audioEncoderFactory(
-					outputFilename, outputSettings, DEFAULT_CHANNELS,
+		AudioFileDevice * fileDev = audioEncoderFactory(
+					outputFilename, m_outputSettings, DEFAULT_CHANNELS,
 					Engine::audioEngine(), successful );
-		if( !successful )
+		if( successful )
 		{
-			delete m_fileDev;
-			m_fileDev = nullptr;
+			return fileDev;
 		}
+		delete fileDev;
 	}
+	return nullptr;
+}
+
+
+
+
+bool ProjectRenderer::addStem( AudioPort * port, const QString & outputFilename )
+{
+	auto device = std::unique_ptr<AudioFileDevice>( createFileDevice( outputFilename ) );
+	if( !device )
+	{
+		return false;
+	}
+	m_stems.push_back( { port, std::move( device ), nullptr } );
+	return true;
 }
 
 
@@ -171,20 +203,50 @@ void ProjectRenderer::run()
 #endif
 
 	PerfLogTimer perfLog("Project Render");
+	PerfLogAccumulator renderLog("Rendering");
+	PerfLogAccumulator encodeLog("Encoding");
+
+	// encoding runs on threads of its own, this thread only renders
+	auto encoder = std::make_unique<AudioEncoderThread>( m_fileDev, &encodeLog );
+	for( auto & stem : m_stems )
+	{
+		stem.encoder = std::make_unique<AudioEncoderThread>( stem.device.get(), &encodeLog );
+	}
 
 	Engine::getSong()->startExport();
 	// Skip first empty buffer.
 	Engine::audioEngine()->nextBuffer();
 
+	// from now on every rendered buffer ends up in the output file, so the
+	// stems have to start here as well to stay in sync with it
+	for( const auto & stem : m_stems )
+	{
+		stem.port->setTap( stem.encoder.get() );
+	}
+
 	m_progress = 0;
 
 	// Now start processing
 	Engine::audioEngine()->startProcessing(false);
 
 	// Continually track and emit progress percentage to listeners.
+	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
 	while (!Engine::getSong()->isExportDone() && !m_abort)
 	{
-		m_fileDev->processNextBuffer();
+		const auto renderStart = PerfLogAccumulator::Clock::now();
+		const SampleFrame* buffer = Engine::audioEngine()->nextBuffer();
+		renderLog.add( PerfLogAccumulator::Clock::now() - renderStart );
+		if( !buffer )
+		{
+			break;
+		}
+
+		encoder->write( buffer, fpp );
+		if( Engine::audioEngine()->hasFifoWriter() )
+		{
+			delete[] buffer;
+		}
+
 		const int nprog = Engine::getSong()->getExportProgress();
 		if (m_progress != nprog)
 		{
@@ -196,15 +258,33 @@ void ProjectRenderer::run()
 	// Notify the audio engine of the end of processing.
 	Engine::audioEngine()->stopProcessing();
 
+	for( const auto & stem : m_stems )
+	{
+		stem.port->setTap( nullptr );
+	}
+
+	// wait for the encoders to catch up
+	encoder->finish();
+	for( const auto & stem : m_stems )
+	{
+		stem.encoder->finish();
+	}
+
 	Engine::getSong()->stopExport();
 
 	perfLog.end();
+	renderLog.end();
+	encodeLog.end();
 
 	// If the user aborted export-process, the file has to be deleted.
 	const QString f = m_fileDev->outputFile();
 	if( m_abort )
 	{
 		QFile( f ).remove();
+		for( const auto & stem : m_stems )
+		{
+			QFile( stem.device->outputFile() ).remove();
+		}
 	}
 }
 
@@ -357,11 +357,23 @@ bool RemotePlugin::process( const SampleFrame* _in_buf, SampleFrame* _out_buf )
 		return false;
 	}
 
-	memset( m_audioBuffer.get(), 0, m_audioBufferSize );
-
 	ch_cnt_t inputs = std::min<ch_cnt_t>(m_inputCount, DEFAULT_CHANNELS);
+	if( _in_buf == nullptr )
+	{
+		inputs = 0;
+	}
 
-	if( _in_buf != nullptr && inputs > 0 )
+	// Only clear what is not overwritten below: input channels we have no
+	// data for (the whole input area unless channels are split, since the
+	// remote side reads it interleaved then), and the outputs, which the
+	// remote side may leave untouched if it skips a period
+	const std::size_t clearedInputSamples = m_splitChannels
+		? static_cast<std::size_t>( m_inputCount - inputs ) * frames
+		: ( inputs < m_inputCount ? static_cast<std::size_t>( m_inputCount ) * frames : 0 );
+	std::fill_n( m_audioBuffer.get() + static_cast<std::size_t>( m_inputCount ) * frames - clearedInputSamples,
+		clearedInputSamples + static_cast<std::size_t>( m_outputCount ) * frames, 0.f );
+
+	if( inputs > 0 )
 	{
 		if( m_splitChannels )
 		{
@@ -27,7 +27,9 @@
 
 #include "RenderManager.h"
 
+#include "InstrumentTrack.h"
 #include "PatternStore.h"
+#include "SampleTrack.h"
 #include "Song.h"
 
 
@@ -44,7 +46,8 @@ RenderManager::RenderManager(
 	m_oldQualitySettings( Engine::audioEngine()->currentQualitySettings() ),
 	m_outputSettings(outputSettings),
 	m_format(fmt),
-	m_outputPath(outputPath)
+	m_outputPath(outputPath),
+	m_failedRenders(0)
 {
 	Engine::audioEngine()->storeAudioDevice();
 }
@@ -95,36 +98,33 @@ void RenderManager::renderNextTrack()
 	}
 }
 
-// Render the song into individual tracks
-void RenderManager::renderTracks()
+std::vector<Track*> RenderManager::renderableTracks()
 {
-	const TrackContainer::TrackList& tl = Engine::getSong()->tracks();
+	std::vector<Track*> tracks;
 
-	// find all currently unnmuted tracks -- we want to render these.
-	for (const auto& tk : tl)
+	for (const auto trackList : {&Engine::getSong()->tracks(), &Engine::patternStore()->tracks()})
 	{
-		Track::Type type = tk->type();
-
-		// Don't render automation tracks
-		if ( tk->isMuted() == false &&
-				( type == Track::Type::Instrument || type == Track::Type::Sample ) )
+		for (const auto& tk : *trackList)
 		{
-			m_unmuted.push_back(tk);
+			Track::Type type = tk->type();
+
+			// Don't render automation tracks
+			if ( tk->isMuted() == false &&
+					( type == Track::Type::Instrument || type == Track::Type::Sample ) )
+			{
+				tracks.push_back(tk);
+			}
 		}
 	}
 
-	const TrackContainer::TrackList& t2 = Engine::patternStore()->tracks();
-	for (const auto& tk : t2)
-	{
-		Track::Type type = tk->type();
+	return tracks;
+}
 
-		// Don't render automation tracks
-		if ( tk->isMuted() == false &&
-				( type == Track::Type::Instrument || type == Track::Type::Sample ) )
-		{
-			m_unmuted.push_back(tk);
-		}
-	}
+// Render the song into individual tracks
+void RenderManager::renderTracks()
+{
+	// find all currently unnmuted tracks -- we want to render these.
+	m_unmuted = renderableTracks();
 
 	// copy the list of unmuted tracks into our rendering queue.
 	// we need to remember which tracks were unmuted to restore state at the end.
@@ -133,13 +133,22 @@ void RenderManager::renderTracks()
 	renderNextTrack();
 }
 
+// Render the song once, writing every track into its own file on the way
+void RenderManager::renderStems()
+{
+	const QString masterPath = QDir(m_outputPath).filePath(
+		QString("0_%1%2").arg(tr("Master")).arg(ProjectRenderer::getFileExtensionFromFormat(m_format)));
+
+	render(masterPath, renderableTracks());
+}
+
 // Render the song into a single track
 void RenderManager::renderProject()
 {
 	render( m_outputPath );
 }
 
-void RenderManager::render(QString outputPath)
+void RenderManager::render(QString outputPath, const std::vector<Track*>& stems)
 {
 	m_activeRenderer = std::make_unique<ProjectRenderer>(
 			m_qualitySettings,
@@ -147,6 +156,27 @@ void RenderManager::render(QString outputPath)
 			m_format,
 			outputPath);
 
+	// number the stems the same way renderTracks() numbers its files
+	for (std::size_t i = 0; i < stems.size(); ++i)
+	{
+		AudioPort* port = nullptr;
+		if (auto instrumentTrack = dynamic_cast<InstrumentTrack*>(stems[i]))
+		{
+			port = instrumentTrack->audioPort();
+		}
+		else if (auto sampleTrack = dynamic_cast<SampleTrack*>(stems[i]))
+		{
+			port = sampleTrack->audioPort();
+		}
+
+		const QString path = pathForTrack(stems[i], i + 1);
+		if (!port || !m_activeRenderer->addStem(port, path))
+		{
+			qWarning("Could not export track to %s", qPrintable(path));
+			++m_failedRenders;
+		}
+	}
+
 	if( m_activeRenderer->isReady() )
 	{
 		// pass progress signals through
@@ -162,7 +192,8 @@ void RenderManager::render(QString outputPath)
 	}
 	else
 	{
-		qDebug( "Renderer failed to acquire a file device!" );
+		qWarning( "Renderer failed to acquire a file device for %s", qPrintable( outputPath ) );
+		++m_failedRenders;
 		renderNextTrack();
 	}
 }
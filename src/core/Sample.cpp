@@ -26,10 +26,26 @@
 
 #include <cassert>
 
+#include "SampleCache.h"
+#include "Song.h"
+
 namespace lmms {
 
+namespace {
+// Scratch space for the not yet resampled frames. It is shared by all samples played on a thread and only grows
+// until it can hold the largest chunk, so steady-state playback does not allocate. Chunks are bounded so that
+// extreme pitch ratios cannot make it grow without limit.
+constexpr auto MaxScratchFrames = std::size_t{16384};
+thread_local auto s_scratchBuffer = std::vector<SampleFrame>{};
+
+auto createStream(const std::shared_ptr<const SampleBuffer>& buffer) -> std::shared_ptr<SampleStream>
+{
+	return buffer->streamed() ? SampleStream::create(buffer) : nullptr;
+}
+} // namespace
+
 Sample::Sample(const QString& audioFile)
-	: m_buffer(std::make_shared<SampleBuffer>(audioFile))
+	: m_buffer(SampleCache::get(audioFile))
 	, m_startFrame(0)
 	, m_endFrame(m_buffer->size())
 	, m_loopStartFrame(0)
@@ -61,6 +77,7 @@ Sample::Sample(std::shared_ptr<const SampleBuffer> buffer)
 	, m_endFrame(m_buffer->size())
 	, m_loopStartFrame(0)
 	, m_loopEndFrame(m_buffer->size())
+	, m_stream(createStream(m_buffer))
 {
 }
 
@@ -73,6 +90,7 @@ Sample::Sample(const Sample& other)
 	, m_amplification(other.amplification())
 	, m_frequency(other.frequency())
 	, m_reversed(other.reversed())
+	, m_stream(createStream(m_buffer))
 {
 }
 
@@ -85,6 +103,7 @@ Sample::Sample(Sample&& other)
 	, m_amplification(other.amplification())
 	, m_frequency(other.frequency())
 	, m_reversed(other.reversed())
+	, m_stream(std::move(other.m_stream))
 {
 }
 
@@ -98,6 +117,7 @@ auto Sample::operator=(const Sample& other) -> Sample&
 	m_amplification = other.amplification();
 	m_frequency = other.frequency();
 	m_reversed = other.reversed();
+	m_stream = createStream(m_buffer);
 
 	return *this;
 }
@@ -112,6 +132,7 @@ auto Sample::operator=(Sample&& other) -> Sample&
 	m_amplification = other.amplification();
 	m_frequency = other.frequency();
 	m_reversed = other.reversed();
+	m_stream = std::move(other.m_stream);
 
 	return *this;
 }
@@ -131,17 +152,47 @@ bool Sample::play(SampleFrame* dst, PlaybackState* state, size_t numFrames, floa
 
 	state->m_frameIndex = std::max<int>(m_startFrame, state->m_frameIndex);
 
-	auto playBuffer = std::vector<SampleFrame>(numFrames / resampleRatio + marginSize);
-	playRaw(playBuffer.data(), playBuffer.size(), state, loopMode);
+	const auto reachesLoopEnd = state->m_frameIndex + static_cast<int>(numFrames) > m_loopEndFrame;
+	if (resampleRatio == 1.0 && !state->m_backwards && (loopMode == Loop::Off || !reachesLoopEnd))
+	{
+		// Nothing to resample and no loop point to wrap around, so libsamplerate can be skipped entirely
+		const auto framesWritten = playRaw(dst, numFrames, state, loopMode);
+		std::fill_n(dst + framesWritten, numFrames - framesWritten, SampleFrame{});
+		advance(state, framesWritten, loopMode);
+		state->m_resampling = false;
+	}
+	else
+	{
+		// The resampler's history is stale after frames were played around it
+		if (!state->m_resampling)
+		{
+			state->resampler().reset();
+			state->m_resampling = true;
+		}
+		state->resampler().setRatio(resampleRatio);
 
-	state->resampler().setRatio(resampleRatio);
+		auto outputFrames = std::size_t{0};
+		while (outputFrames < numFrames)
+		{
+			const auto framesLeft = numFrames - outputFrames;
+			const auto inputFrames
+				= std::min(static_cast<std::size_t>(framesLeft / resampleRatio) + marginSize, MaxScratchFrames);
+			if (s_scratchBuffer.size() < inputFrames) { s_scratchBuffer.resize(inputFrames); }
+
+			const auto playBuffer = s_scratchBuffer.data();
+			const auto framesWritten = playRaw(playBuffer, inputFrames, state, loopMode);
+			std::fill_n(playBuffer + framesWritten, inputFrames - framesWritten, SampleFrame{});
 
-	const auto resampleResult
-		= state->resampler().resample(&playBuffer[0][0], playBuffer.size(), &dst[0][0], numFrames, resampleRatio);
-	advance(state, resampleResult.inputFramesUsed, loopMode);
+			const auto resampleResult = state->resampler().resample(
+				&playBuffer[0][0], inputFrames, &dst[outputFrames][0], framesLeft, resampleRatio);
+			advance(state, resampleResult.inputFramesUsed, loopMode);
 
-	const auto outputFrames = resampleResult.outputFramesGenerated;
-	if (outputFrames < numFrames) { std::fill_n(dst + outputFrames, numFrames - outputFrames, SampleFrame{}); }
+			if (resampleResult.outputFramesGenerated <= 0) { break; }
+			outputFrames += resampleResult.outputFramesGenerated;
+		}
+
+		if (outputFrames < numFrames) { std::fill_n(dst + outputFrames, numFrames - outputFrames, SampleFrame{}); }
+	}
 
 	if (!typeInfo<float>::isEqual(m_amplification, 1.0f))
 	{
@@ -170,9 +221,10 @@ void Sample::setAllPointFrames(int startFrame, int endFrame, int loopStartFrame,
 	setLoopEndFrame(loopEndFrame);
 }
 
-void Sample::playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const
+auto Sample::playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const -> size_t
 {
-	if (m_buffer->size() < 1) { return; }
+	if (m_buffer->size() < 1) { return 0; }
+	if (m_stream) { return playStreamed(dst, numFrames, state); }
 
 	auto index = state->m_frameIndex;
 	auto backwards = state->m_backwards;
@@ -182,7 +234,7 @@ void Sample::playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* st
 		switch (loopMode)
 		{
 		case Loop::Off:
-			if (index < 0 || index >= m_endFrame) { return; }
+			if (index < 0 || index >= m_endFrame) { return i; }
 			break;
 		case Loop::On:
 			if (index < m_loopStartFrame && backwards) { index = m_loopEndFrame - 1; }
@@ -207,6 +259,21 @@ void Sample::playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* st
 		dst[i] = m_buffer->data()[m_reversed ? m_buffer->size() - index - 1 : index];
 		backwards ? --index : ++index;
 	}
+
+	return numFrames;
+}
+
+auto Sample::playStreamed(SampleFrame* dst, size_t numFrames, const PlaybackState* state) const -> size_t
+{
+	// Streams are read from front to back, so loops and backwards playback are not supported
+	const auto index = state->m_frameIndex;
+	if (index < 0 || index >= m_endFrame) { return 0; }
+
+	// Rendering runs faster than the disk is polled, so it waits for the frames instead of dropping them
+	const auto offline = Engine::audioEngine()->renderOnly() || Engine::getSong()->isExporting();
+	const auto frames = std::min<size_t>(numFrames, m_endFrame - index);
+	m_stream->read(dst, index, frames, m_reversed, offline);
+	return frames;
 }
 
 void Sample::advance(PlaybackState* state, size_t advanceAmount, Loop loopMode) const
@@ -27,6 +27,7 @@
 
 #include "PathUtil.h"
 #include "SampleDecoder.h"
+#include "SampleDiskCache.h"
 #include "lmms_basics.h"
 
 namespace lmms {
@@ -42,9 +43,20 @@ SampleBuffer::SampleBuffer(const QString& audioFile)
 	if (audioFile.isEmpty()) { throw std::runtime_error{"Failure loading audio file: Audio file path is empty."}; }
 	const auto absolutePath = PathUtil::toAbsolute(audioFile);
 
+	const auto cacheKey = SampleDiskCache::key(absolutePath);
+	if (auto mapping = SampleDiskCache::load(cacheKey))
+	{
+		m_mapped = std::move(mapping->data);
+		m_mappedFrames = mapping->frames;
+		m_sampleRate = mapping->sampleRate;
+		m_audioFile = PathUtil::toShortestRelative(audioFile);
+		return;
+	}
+
 	if (auto decodedResult = SampleDecoder::decode(absolutePath))
 	{
 		auto& [data, sampleRate] = *decodedResult;
+		SampleDiskCache::store(cacheKey, data, sampleRate);
 		m_data = std::move(data);
 		m_sampleRate = sampleRate;
 		m_audioFile = PathUtil::toShortestRelative(audioFile);
@@ -55,6 +67,15 @@ SampleBuffer::SampleBuffer(const QString& audioFile)
 		"Failed to decode audio file: Either the audio codec is unsupported, or the file is corrupted."};
 }
 
+SampleBuffer::SampleBuffer(
+	const QString& audioFile, std::vector<SampleFrame> head, StreamInfo streamInfo, int sampleRate)
+	: m_data(std::move(head))
+	, m_streamInfo(std::move(streamInfo))
+	, m_audioFile(PathUtil::toShortestRelative(audioFile))
+	, m_sampleRate(sampleRate)
+{
+}
+
 SampleBuffer::SampleBuffer(const QString& base64, int sampleRate)
 	: m_sampleRate(sampleRate)
 {
@@ -74,6 +95,9 @@ void swap(SampleBuffer& first, SampleBuffer& second) noexcept
 {
 	using std::swap;
 	swap(first.m_data, second.m_data);
+	swap(first.m_mapped, second.m_mapped);
+	swap(first.m_mappedFrames, second.m_mappedFrames);
+	swap(first.m_streamInfo, second.m_streamInfo);
 	swap(first.m_audioFile, second.m_audioFile);
 	swap(first.m_sampleRate, second.m_sampleRate);
 }
@@ -81,8 +105,8 @@ void swap(SampleBuffer& first, SampleBuffer& second) noexcept
 QString SampleBuffer::toBase64() const
 {
 	// TODO: Replace with non-Qt equivalent
-	const auto data = reinterpret_cast<const char*>(m_data.data());
-	const auto size = static_cast<int>(m_data.size() * sizeof(SampleFrame));
+	const auto data = reinterpret_cast<const char*>(this->data());
+	const auto size = static_cast<int>((m_mapped ? m_mappedFrames : m_data.size()) * sizeof(SampleFrame));
 	const auto byteArray = QByteArray{data, size};
 	return byteArray.toBase64();
 }
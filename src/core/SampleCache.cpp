@@ -0,0 +1,229 @@
+/*
+ * SampleCache.cpp - process-wide cache of decoded audio files
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "SampleCache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <iterator>
+
+#include "PathUtil.h"
+#include "PerfLog.h"
+#include "SampleStream.h"
+#include "ThreadPool.h"
+
+namespace lmms {
+
+namespace {
+auto bufferBytes(const SampleBuffer& buffer) -> std::size_t
+{
+	const auto frames = buffer.streamed()
+		? buffer.head().size() + buffer.head(true).size() + buffer.overview().size()
+		: buffer.size();
+	return frames * sizeof(SampleFrame);
+}
+} // namespace
+
+auto SampleCache::get(const QString& audioFile) -> std::shared_ptr<const SampleBuffer>
+{
+	return fetch(audioFile, false);
+}
+
+auto SampleCache::getStreamed(const QString& audioFile) -> std::shared_ptr<const SampleBuffer>
+{
+	return fetch(audioFile, true);
+}
+
+auto SampleCache::prefetch(const QString& audioFile, bool streamed, PerfLogAccumulator* log)
+	-> std::shared_future<std::shared_ptr<const SampleBuffer>>
+{
+	const auto file = FileInfo{audioFile, streamed};
+
+	const auto lock = std::lock_guard{s_mutex};
+	if (auto buffer = lookup(file))
+	{
+		auto ready = std::promise<std::shared_ptr<const SampleBuffer>>{};
+		ready.set_value(std::move(buffer));
+		return ready.get_future().share();
+	}
+
+	if (const auto it = s_pending.find(file.key); it != s_pending.end()) { return *it; }
+
+	auto future = ThreadPool::instance().enqueue([audioFile, key = file.key, streamed, log] {
+		const auto start = PerfLogAccumulator::Clock::now();
+
+		auto buffer = std::shared_ptr<const SampleBuffer>{};
+		try
+		{
+			buffer = load(audioFile, streamed);
+		}
+		catch (const std::runtime_error&)
+		{
+			// reported when the file is requested again
+		}
+
+		{
+			const auto lock = std::lock_guard{s_mutex};
+			s_pending.remove(key);
+		}
+
+		if (log) { log->add(PerfLogAccumulator::Clock::now() - start); }
+		return buffer;
+	}).share();
+
+	s_pending.insert(file.key, future);
+	return future;
+}
+
+SampleCache::FileInfo::FileInfo(const QString& audioFile, bool streamed)
+	: path(PathUtil::toAbsolute(audioFile))
+	, key(streamed ? QStringLiteral("stream:") + path : path)
+{
+	const auto info = QFileInfo{path};
+	size = info.size();
+	modified = info.lastModified().toMSecsSinceEpoch();
+}
+
+auto SampleCache::fetch(const QString& audioFile, bool streamed) -> std::shared_ptr<const SampleBuffer>
+{
+	if (audioFile.isEmpty()) { return std::make_shared<const SampleBuffer>(audioFile); }
+
+	const auto key = FileInfo{audioFile, streamed}.key;
+	auto pending = std::shared_future<std::shared_ptr<const SampleBuffer>>{};
+	{
+		const auto lock = std::lock_guard{s_mutex};
+		if (const auto it = s_pending.find(key); it != s_pending.end()) { pending = *it; }
+	}
+
+	if (pending.valid())
+	{
+		if (auto buffer = pending.get()) { return buffer; }
+	}
+
+	return load(audioFile, streamed);
+}
+
+auto SampleCache::load(const QString& audioFile, bool streamed) -> std::shared_ptr<const SampleBuffer>
+{
+	const auto file = FileInfo{audioFile, streamed};
+
+	{
+		const auto lock = std::lock_guard{s_mutex};
+		if (auto buffer = lookup(file)) { return buffer; }
+	}
+
+	// Decode without holding the lock, so loading other files is not blocked. If two threads load the same file
+	// at once, both decode it and the later one replaces the earlier entry, which stays valid for its users.
+	auto buffer = std::shared_ptr<const SampleBuffer>{};
+	if (streamed)
+	{
+		buffer = SampleStream::createBuffer(audioFile);
+		// short files are cached like any other
+		if (!buffer) { return load(audioFile, false); }
+	}
+	else { buffer = std::make_shared<const SampleBuffer>(audioFile); }
+
+	const auto lock = std::lock_guard{s_mutex};
+
+	// forget files nobody uses anymore
+	for (auto it = s_entries.begin(); it != s_entries.end();)
+	{
+		if (it->recent == s_recent.end() && it->buffer.expired()) { it = s_entries.erase(it); }
+		else { ++it; }
+	}
+
+	auto it = s_entries.find(file.key);
+	if (it == s_entries.end())
+	{
+		it = s_entries.insert(file.key, Entry{file.size, file.modified, buffer, s_recent.end()});
+	}
+	else
+	{
+		it->size = file.size;
+		it->modified = file.modified;
+		it->buffer = buffer;
+	}
+	touch(file.key, *it, buffer);
+	trim();
+
+	return buffer;
+}
+
+auto SampleCache::lookup(const FileInfo& file) -> std::shared_ptr<const SampleBuffer>
+{
+	const auto it = s_entries.find(file.key);
+	if (it == s_entries.end() || it->size != file.size || it->modified != file.modified) { return nullptr; }
+
+	auto buffer = it->buffer.lock();
+	if (buffer) { touch(file.key, *it, buffer); }
+	return buffer;
+}
+
+void SampleCache::setByteBudget(std::size_t bytes)
+{
+	const auto lock = std::lock_guard{s_mutex};
+	s_byteBudget = bytes;
+	trim();
+}
+
+void SampleCache::clear()
+{
+	const auto lock = std::lock_guard{s_mutex};
+	s_entries.clear();
+	s_recent.clear();
+	s_recentBytes = 0;
+}
+
+void SampleCache::touch(const QString& key, Entry& entry, std::shared_ptr<const SampleBuffer> buffer)
+{
+	if (entry.recent != s_recent.end())
+	{
+		s_recentBytes -= bufferBytes(*entry.recent->buffer);
+		s_recent.erase(entry.recent);
+	}
+
+	s_recentBytes += bufferBytes(*buffer);
+	s_recent.push_front(Recent{key, std::move(buffer)});
+	entry.recent = s_recent.begin();
+}
+
+void SampleCache::trim()
+{
+	while (s_recentBytes > s_byteBudget && !s_recent.empty())
+	{
+		const auto& oldest = s_recent.back();
+		s_recentBytes -= bufferBytes(*oldest.buffer);
+
+		const auto it = s_entries.find(oldest.key);
+		if (it != s_entries.end() && it->recent == std::prev(s_recent.end()))
+		{
+			if (oldest.buffer.use_count() == 1) { s_entries.erase(it); }
+			else { it->recent = s_recent.end(); }
+		}
+		s_recent.pop_back();
+	}
+}
+
+} // namespace lmms
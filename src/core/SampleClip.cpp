@@ -150,7 +150,9 @@ void SampleClip::setSampleFile(const QString& sf)
 	if (!sf.isEmpty())
 	{
 		//Otherwise set it to the sample's length
-		m_sample = Sample(gui::SampleLoader::createBufferFromFile(sf));
+		auto buffer = gui::SampleLoader::createStreamedBufferFromFile(sf);
+		const auto guard = Engine::audioEngine()->requestChangesGuard();
+		m_sample = Sample(std::move(buffer));
 		length = sampleLength();
 	}
 
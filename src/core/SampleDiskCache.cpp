@@ -0,0 +1,163 @@
+/*
+ * SampleDiskCache.cpp - decoded audio files kept on disk for mapping
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "SampleDiskCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cstdint>
+#include <cstring>
+
+#include "AudioEngine.h"
+#include "ConfigManager.h"
+#include "Engine.h"
+#include "lmmsversion.h"
+
+namespace lmms {
+
+namespace {
+// Version 1 entries may hold DrumSynth renders corrupted by concurrent decoding
+constexpr auto CacheVersion = std::uint32_t{2};
+
+struct Header
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t sampleRate;
+	std::uint64_t frames;
+	std::uint32_t frameSize;
+	char lmmsVersion[36];
+};
+static_assert(sizeof(Header) == 64);
+
+auto makeHeader(std::uint32_t sampleRate, std::uint64_t frames) -> Header
+{
+	auto header = Header{};
+	std::memcpy(header.magic, "LMMSPCM", 8);
+	header.version = CacheVersion;
+	header.sampleRate = sampleRate;
+	header.frames = frames;
+	header.frameSize = sizeof(SampleFrame);
+	std::strncpy(header.lmmsVersion, LMMS_VERSION, sizeof(header.lmmsVersion) - 1);
+	return header;
+}
+
+auto cacheDir() -> QString
+{
+	return ConfigManager::inst()->cacheDir() + "samples/";
+}
+
+auto cacheFile(const QByteArray& key) -> QString
+{
+	return cacheDir() + QString::fromLatin1(key) + ".pcm";
+}
+
+//! Removes the least recently used entries until the cache fits into its budget, see SampleDiskCache::load()
+void trim()
+{
+	const auto entries = QDir{cacheDir()}.entryInfoList({"*.pcm"}, QDir::Files, QDir::Time | QDir::Reversed);
+
+	auto total = std::int64_t{0};
+	for (const auto& entry : entries) { total += entry.size(); }
+
+	for (const auto& entry : entries)
+	{
+		if (total <= SampleDiskCache::ByteBudget) { break; }
+		if (QFile::remove(entry.absoluteFilePath())) { total -= entry.size(); }
+	}
+}
+} // namespace
+
+auto SampleDiskCache::key(const QString& audioFile) -> QByteArray
+{
+	if (ConfigManager::inst()->value("app", "nosamplecache").toInt()) { return {}; }
+
+	// Uncompressed files are read about as fast as their cached frames would be
+	const auto suffix = QFileInfo{audioFile}.suffix().toLower();
+	if (suffix == "wav" || suffix == "aif" || suffix == "aiff") { return {}; }
+
+	auto file = QFile{audioFile};
+	if (!file.open(QIODevice::ReadOnly)) { return {}; }
+
+	auto hash = QCryptographicHash{QCryptographicHash::Sha1};
+	if (!hash.addData(&file)) { return {}; }
+
+	// DrumSynth files are rendered at the output sample rate
+	if (suffix == "ds") { hash.addData(QByteArray::number(Engine::audioEngine()->outputSampleRate())); }
+
+	return hash.result().toHex();
+}
+
+auto SampleDiskCache::load(const QByteArray& key) -> std::optional<Mapping>
+{
+	if (key.isEmpty()) { return std::nullopt; }
+
+	const auto file = std::make_shared<QFile>(cacheFile(key));
+	if (!file->open(QIODevice::ReadOnly)) { return std::nullopt; }
+
+	auto header = Header{};
+	if (file->read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)) { return std::nullopt; }
+
+	const auto expected = makeHeader(header.sampleRate, header.frames);
+	const auto bytes = header.frames * sizeof(SampleFrame);
+	if (std::memcmp(&header, &expected, sizeof(header)) != 0 || header.frames == 0
+		|| static_cast<std::uint64_t>(file->size()) != sizeof(header) + bytes)
+	{
+		return std::nullopt;
+	}
+
+	// Mapped privately, so nothing done to the buffer's frames can reach the cached file
+	const auto data = file->map(sizeof(header), bytes, QFileDevice::MapPrivateOption);
+	if (!data) { return std::nullopt; }
+
+	// Eviction goes by modification time, so every hit moves the entry to the back of the queue
+#if (QT_VERSION >= QT_VERSION_CHECK(5,10,0))
+	file->setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+#endif
+
+	return Mapping{std::shared_ptr<SampleFrame>{file, reinterpret_cast<SampleFrame*>(data)},
+		static_cast<std::size_t>(header.frames), static_cast<int>(header.sampleRate)};
+}
+
+void SampleDiskCache::store(const QByteArray& key, const std::vector<SampleFrame>& data, int sampleRate)
+{
+	if (key.isEmpty() || data.empty()) { return; }
+
+	QDir().mkpath(cacheDir());
+
+	QSaveFile file(cacheFile(key));
+	if (!file.open(QIODevice::WriteOnly)) { return; }
+
+	const auto header = makeHeader(sampleRate, data.size());
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(SampleFrame));
+	if (file.commit()) { trim(); }
+}
+
+} // namespace lmms
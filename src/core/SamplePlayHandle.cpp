@@ -126,6 +126,16 @@ void SamplePlayHandle::play( SampleFrame* buffer )
 
 
 
+void SamplePlayHandle::restart( Sample* sample )
+{
+	m_sample = sample;
+	m_frame = 0;
+	m_state.reset();
+}
+
+
+
+
 bool SamplePlayHandle::isFinished() const
 {
 	return framesDone() >= totalFrames() && m_doneMayReturnTrue == true;
@@ -0,0 +1,324 @@
+/*
+ * SampleStream.cpp - reads long audio files from disk while they play
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "SampleStream.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <sndfile.h>
+#include <thread>
+
+#include "PathUtil.h"
+
+namespace lmms {
+
+namespace {
+// While streams are being read, the I/O thread polls them instead of being woken by every read
+constexpr auto PollInterval = std::chrono::milliseconds{5};
+
+struct IoThread
+{
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable idle; //!< notified after every pass over the streams
+	std::vector<std::weak_ptr<SampleStream>> streams;
+	std::thread thread;
+	bool quit = false;
+
+	std::atomic<bool> active = false; //!< set by readers, the thread parks once a poll interval passes without it
+	std::atomic<bool> parked = false;
+
+	~IoThread()
+	{
+		{
+			const auto lock = std::lock_guard{mutex};
+			quit = true;
+		}
+		wake.notify_all();
+		if (thread.joinable()) { thread.join(); }
+	}
+};
+
+auto ioThread() -> IoThread&
+{
+	static auto s_ioThread = IoThread{};
+	return s_ioThread;
+}
+
+auto toFrame(const float* samples, int channels) -> SampleFrame
+{
+	// like SampleDecoder, upmix mono and only use the first two channels of anything else
+	return channels == 1 ? SampleFrame{samples[0]} : SampleFrame{samples[0], samples[1]};
+}
+} // namespace
+
+auto SampleStream::createBuffer(const QString& audioFile) -> std::shared_ptr<const SampleBuffer>
+{
+	if (audioFile.isEmpty()) { return nullptr; }
+
+	auto file = QFile{PathUtil::toAbsolute(audioFile)};
+	if (!file.open(QIODevice::ReadOnly)) { return nullptr; }
+
+	auto info = SF_INFO{};
+	const auto sndFile = sf_open_fd(file.handle(), SFM_READ, &info, false);
+	if (!sndFile) { return nullptr; }
+
+	const auto frames = static_cast<std::size_t>(info.frames);
+	if (!info.seekable || info.channels < 1 || frames * sizeof(SampleFrame) <= ThresholdBytes)
+	{
+		sf_close(sndFile);
+		return nullptr;
+	}
+
+	// A single pass over the file collects the head and the overview
+	constexpr auto BlockFrames = SampleBuffer::OverviewBlockFrames;
+	auto head = std::vector<SampleFrame>{};
+	head.reserve(HeadFrames);
+	auto streamInfo = SampleBuffer::StreamInfo{frames, {}, {}};
+	streamInfo.overview.reserve(2 * (frames / BlockFrames + 1));
+
+	auto chunk = std::vector<float>(ChunkFrames * info.channels);
+	auto read = sf_count_t{0};
+	while ((read = sf_readf_float(sndFile, chunk.data(), ChunkFrames)) > 0)
+	{
+		for (auto block = sf_count_t{0}; block < read; block += BlockFrames)
+		{
+			auto max = SampleFrame{-1.f};
+			auto min = SampleFrame{1.f};
+			for (auto i = block; i < std::min<sf_count_t>(block + BlockFrames, read); ++i)
+			{
+				const auto frame = toFrame(&chunk[i * info.channels], info.channels);
+				if (head.size() < HeadFrames) { head.push_back(frame); }
+				max = {std::max(max.left(), frame.left()), std::max(max.right(), frame.right())};
+				min = {std::min(min.left(), frame.left()), std::min(min.right(), frame.right())};
+			}
+			streamInfo.overview.push_back(max);
+			streamInfo.overview.push_back(min);
+		}
+	}
+
+	// Reversed playback starts at the end of the file
+	const auto tailFrames = std::min(HeadFrames, frames);
+	auto tail = std::vector<float>(tailFrames * info.channels);
+	sf_seek(sndFile, frames - tailFrames, SEEK_SET);
+	const auto tailRead = std::max<sf_count_t>(sf_readf_float(sndFile, tail.data(), tailFrames), 0);
+	streamInfo.reversedHead.reserve(tailRead);
+	for (auto i = tailRead; i-- > 0;)
+	{
+		streamInfo.reversedHead.push_back(toFrame(&tail[i * info.channels], info.channels));
+	}
+
+	sf_close(sndFile);
+
+	return std::make_shared<const SampleBuffer>(audioFile, std::move(head), std::move(streamInfo), info.samplerate);
+}
+
+auto SampleStream::create(std::shared_ptr<const SampleBuffer> buffer) -> std::shared_ptr<SampleStream>
+{
+	auto stream = std::shared_ptr<SampleStream>{new SampleStream{std::move(buffer)}};
+
+	// the thread preloads the ring right away
+	auto& io = ioThread();
+	const auto lock = std::lock_guard{io.mutex};
+	io.streams.push_back(stream);
+	io.active = true;
+	if (!io.thread.joinable()) { io.thread = std::thread{&SampleStream::run}; }
+	io.wake.notify_all();
+	return stream;
+}
+
+SampleStream::SampleStream(std::shared_ptr<const SampleBuffer> buffer)
+	: m_buffer(std::move(buffer))
+	, m_file(PathUtil::toAbsolute(m_buffer->audioFile()))
+	, m_ring(RingFrames)
+{
+	if (m_file.open(QIODevice::ReadOnly))
+	{
+		auto info = SF_INFO{};
+		m_sndFile = sf_open_fd(m_file.handle(), SFM_READ, &info, false);
+		m_channels = info.channels;
+	}
+	m_chunk.resize(ChunkFrames * std::max(m_channels, 1));
+
+	// the ring continues where the head ends
+	const auto headFrames = m_buffer->head().size();
+	m_requestedPosition = headFrames;
+	m_consumed = headFrames;
+	m_end = headFrames;
+}
+
+SampleStream::~SampleStream()
+{
+	// the I/O thread drops expired streams on its own
+	if (m_sndFile) { sf_close(m_sndFile); }
+}
+
+void SampleStream::read(SampleFrame* dst, std::size_t position, std::size_t frames, bool reversed, bool wait)
+{
+	// A parked thread is woken without the lock to stay realtime safe. If that wakeup gets lost, the next read
+	// repeats it; until then, the head or the ring still has frames to play.
+	auto& io = ioThread();
+	io.active.store(true);
+	if (io.parked.load()) { io.wake.notify_one(); }
+
+	const auto& head = m_buffer->head(reversed);
+	auto done = std::size_t{0};
+	if (position < head.size())
+	{
+		done = std::min(frames, head.size() - position);
+		std::copy_n(head.data() + position, done, dst);
+	}
+
+	// everything after the head comes from the ring
+	const auto target = std::max(position, head.size());
+	const auto consumed = m_consumed.load(std::memory_order_relaxed);
+	if (reversed != m_reversed || target < consumed || target >= consumed + RingFrames) { restart(target, reversed); }
+	else { m_consumed.store(target, std::memory_order_release); }
+
+	// the I/O thread never reads further ahead than the ring holds
+	if (wait && done < frames && m_sndFile)
+	{
+		waitFor(std::min({target + frames - done, target + RingFrames, m_buffer->size()}));
+	}
+
+	if (done < frames && m_readyEpoch.load(std::memory_order_acquire) == m_epoch)
+	{
+		const auto end = m_end.load(std::memory_order_acquire);
+		const auto available = target < end ? std::min(frames - done, end - target) : 0;
+		for (auto i = std::size_t{0}; i < available; ++i)
+		{
+			dst[done + i] = m_ring[(target + i) % RingFrames];
+		}
+		done += available;
+	}
+
+	std::fill(dst + done, dst + frames, SampleFrame{});
+}
+
+void SampleStream::restart(std::size_t position, bool reversed)
+{
+	m_reversed = reversed;
+	m_consumed.store(position, std::memory_order_relaxed);
+	m_requestedPosition.store(position, std::memory_order_relaxed);
+	m_requestedReversed.store(reversed, std::memory_order_relaxed);
+	m_requestedEpoch.store(++m_epoch, std::memory_order_release);
+}
+
+void SampleStream::waitFor(std::size_t end)
+{
+	auto& io = ioThread();
+	auto lock = std::unique_lock{io.mutex};
+	io.active = true;
+	io.wake.notify_all();
+	io.idle.wait(lock, [this, end] {
+		return m_readyEpoch.load(std::memory_order_acquire) == m_epoch
+			&& m_end.load(std::memory_order_acquire) >= end;
+	});
+}
+
+auto SampleStream::fill() -> bool
+{
+	if (!m_sndFile) { return false; }
+
+	if (const auto epoch = m_requestedEpoch.load(std::memory_order_acquire); epoch != m_servedEpoch)
+	{
+		// The reader may have moved on since it requested the restart
+		const auto position = std::max(
+			m_requestedPosition.load(std::memory_order_relaxed), m_consumed.load(std::memory_order_acquire));
+		m_servedReversed = m_requestedReversed.load(std::memory_order_relaxed);
+		m_servedEpoch = epoch;
+		m_end.store(position, std::memory_order_relaxed);
+		m_readyEpoch.store(epoch, std::memory_order_release);
+	}
+
+	const auto end = m_end.load(std::memory_order_relaxed);
+	const auto limit = std::min(m_consumed.load(std::memory_order_acquire) + RingFrames, m_buffer->size());
+	if (end >= limit) { return false; }
+
+	// chunks never wrap around the end of the ring
+	const auto frames = std::min({limit - end, ChunkFrames, RingFrames - end % RingFrames});
+	const auto filePosition = m_servedReversed ? m_buffer->size() - end - frames : end;
+	const auto read = readFile(filePosition, frames);
+
+	const auto ring = m_ring.data() + end % RingFrames;
+	for (auto i = std::size_t{0}; i < frames; ++i)
+	{
+		const auto index = m_servedReversed ? frames - 1 - i : i;
+		ring[i] = index < read ? toFrame(&m_chunk[index * m_channels], m_channels) : SampleFrame{};
+	}
+
+	m_end.store(end + frames, std::memory_order_release);
+	return true;
+}
+
+auto SampleStream::readFile(std::size_t filePosition, std::size_t frames) -> std::size_t
+{
+	if (filePosition != m_filePosition && sf_seek(m_sndFile, filePosition, SEEK_SET) < 0) { return 0; }
+
+	const auto read = static_cast<std::size_t>(std::max<sf_count_t>(sf_readf_float(m_sndFile, m_chunk.data(), frames), 0));
+	m_filePosition = filePosition + read;
+	return read;
+}
+
+void SampleStream::run()
+{
+	auto& io = ioThread();
+	auto streams = std::vector<std::shared_ptr<SampleStream>>{};
+	auto lock = std::unique_lock{io.mutex};
+	while (!io.quit)
+	{
+		io.streams.erase(std::remove_if(io.streams.begin(), io.streams.end(),
+			[](const auto& stream) { return stream.expired(); }), io.streams.end());
+		for (const auto& stream : io.streams)
+		{
+			if (auto locked = stream.lock()) { streams.push_back(std::move(locked)); }
+		}
+
+		// The disk is read without the lock, so creating streams never waits for it
+		lock.unlock();
+		auto busy = false;
+		for (const auto& stream : streams)
+		{
+			busy = stream->fill() || busy;
+		}
+		streams.clear();
+		lock.lock();
+
+		io.idle.notify_all();
+		if (busy) { continue; }
+
+		if (io.active.exchange(false)) { io.wake.wait_for(lock, PollInterval); }
+		else
+		{
+			// nothing has been read since the last poll, e.g. because the transport is stopped
+			io.parked = true;
+			io.wake.wait(lock, [&io] { return io.quit || io.active.load(); });
+			io.parked = false;
+		}
+	}
+}
+
+} // namespace lmms
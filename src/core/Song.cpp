@@ -27,6 +27,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
 #include <QMessageBox>
 
 #include <algorithm>
@@ -56,6 +57,8 @@
 #include "SongEditor.h"
 #include "TimeLineWidget.h"
 #include "PeakController.h"
+#include "PerfLog.h"
+#include "SampleCache.h"
 
 
 namespace lmms
@@ -96,8 +99,7 @@ Song::Song() :
 	m_elapsedTicks( 0 ),
 	m_elapsedBars( 0 ),
 	m_loopRenderCount(1),
-	m_loopRenderRemaining(1),
-	m_oldAutomatedValues()
+	m_loopRenderRemaining(1)
 {
 	for (double& millisecondsElapsed : m_elapsedMilliSeconds) { millisecondsElapsed = 0; }
 	connect( &m_tempoModel, SIGNAL(dataChanged()),
@@ -354,10 +356,6 @@ void Song::processNextBuffer()
 
 void Song::processAutomations(const TrackList &tracklist, TimePos timeStart, fpp_t)
 {
-	AutomatedValueMap values;
-
-	QSet<const AutomatableModel*> recordedModels;
-
 	TrackContainer* container = this;
 	int clipNum = -1;
 
@@ -378,55 +376,42 @@ void Song::processAutomations(const TrackList &tracklist, TimePos timeStart, fpp
 		return;
 	}
 
-	values = container->automatedValuesAt(timeStart, clipNum);
-	const TrackList& tracks = container->tracks();
-
-	Track::clipVector clips;
-	for (Track* track : tracks)
+	// The routing table mirrors automatedValuesAt() of the container, but is
+	// only rebuilt after the arrangement changed
+	if (!m_automationRouting.isValidFor(clipNum))
 	{
-		if (track->type() == Track::Type::Automation) {
-			track->getClipsInRange(clips, 0, timeStart);
+		if (clipNum < 0)
+		{
+			auto trackList = TrackList{m_globalAutomationTrack};
+			trackList.insert(trackList.end(), tracks().begin(), tracks().end());
+			m_automationRouting.rebuild(trackList, clipNum);
+		}
+		else
+		{
+			m_automationRouting.rebuild(container->tracks(), clipNum);
 		}
 	}
+	m_automationRouting.evaluate(clipNum < 0
+		? timeStart
+		: AutomationRoutingTable::patternTime(timeStart, clipNum));
 
 	// Process recording
-	for (Clip* clip : clips)
+	for (AutomationClip* p : m_automationRouting.recordableClips())
 	{
-		auto p = dynamic_cast<AutomationClip *>(clip);
+		if (p->startPosition() > timeStart) { continue; }
+
 		TimePos relTime = timeStart - p->startPosition();
 		if (p->isRecording() && relTime >= 0 && relTime < p->length())
 		{
 			const AutomatableModel* recordedModel = p->firstObject();
 			p->recordValue(relTime, recordedModel->value<float>());
 
-			recordedModels << recordedModel;
+			m_automationRouting.markRecorded(recordedModel);
 		}
 	}
 
-	// Checks if an automated model stopped being automated by automation clip
-	// so we can move the control back to any connected controller again
-	for (auto it = m_oldAutomatedValues.begin(); it != m_oldAutomatedValues.end(); it++)
-	{
-		AutomatableModel * am = it.key();
-		if (am->controllerConnection() && !values.contains(am))
-		{
-			am->setUseControllerValue(true);
-		}
-	}
-	m_oldAutomatedValues = values;
-
 	// Apply values
-	for (auto it = values.begin(); it != values.end(); it++)
-	{
-		if (! recordedModels.contains(it.key()))
-		{
-			it.key()->setAutomatedValue(it.value());
-		}
-		else if (!it.key()->useControllerValue())
-		{
-			it.key()->setUseControllerValue(true);
-		}
-	}
+	m_automationRouting.apply();
 }
 
 void Song::setModified(bool value)
@@ -684,12 +669,7 @@ void Song::stop()
 
 	// Moves the control of the models that were processed on the last frame
 	// back to their controllers.
-	for (auto it = m_oldAutomatedValues.begin(); it != m_oldAutomatedValues.end(); it++)
-	{
-		AutomatableModel * am = it.key();
-		am->setUseControllerValue(true);
-	}
-	m_oldAutomatedValues.clear();
+	m_automationRouting.release();
 
 	m_playMode = PlayMode::None;
 
@@ -888,8 +868,8 @@ void Song::clearProject()
 	m_masterPitchModel.reset();
 	m_timeSigModel.reset();
 
-	// Clear the m_oldAutomatedValues AutomatedValueMap
-	m_oldAutomatedValues.clear();
+	// Forget the models that were automated before
+	m_automationRouting.clear();
 
 	AutomationClip::globalAutomationClip( &m_tempoModel )->clear();
 	AutomationClip::globalAutomationClip( &m_masterVolumeModel )->
@@ -993,6 +973,39 @@ void Song::createNewProjectFromTemplate( const QString & templ )
 
 
 
+namespace
+{
+
+//! Starts decoding the samples used by the project on the thread pool, so
+//! restoring the tracks mostly finds them decoded already
+auto prefetchSamples(DataFile& dataFile, PerfLogAccumulator* log)
+	-> std::vector<std::shared_future<std::shared_ptr<const SampleBuffer>>>
+{
+	auto samples = std::vector<std::shared_future<std::shared_ptr<const SampleBuffer>>>{};
+	const auto prefetch = [&](const QString& tagName, bool streamed)
+	{
+		const auto elements = dataFile.content().elementsByTagName(tagName);
+		for (int i = 0; i < elements.count(); ++i)
+		{
+			const auto src = elements.at(i).toElement().attribute("src");
+			// DrumSynth decodes one file at a time, so those are left to the tracks to decode when they load
+			if (src.isEmpty() || QFileInfo{src}.suffix().toLower() == "ds") { continue; }
+			samples.push_back(SampleCache::prefetch(src, streamed, log));
+		}
+	};
+
+	// sample clips stream long files, see SampleClip::setSampleFile()
+	prefetch("sampleclip", true);
+	prefetch("audiofileprocessor", false);
+	prefetch("slicert", false);
+	return samples;
+}
+
+} // namespace
+
+
+
+
 // load given song
 void Song::loadProject( const QString & fileName )
 {
@@ -1059,6 +1072,10 @@ void Song::loadProject( const QString & fileName )
 
 	clearErrors();
 
+	// decode samples in the background while the tracks are restored
+	PerfLogAccumulator decodeLog("Sample decoding");
+	const auto samples = prefetchSamples(dataFile, &decodeLog);
+
 	Engine::audioEngine()->requestChangeInModel();
 
 	// get the header information from the DOM
@@ -1159,6 +1176,17 @@ void Song::loadProject( const QString & fileName )
 		node = node.nextSibling();
 	}
 
+	{
+		// samples nobody asked for yet, e.g. after cancelling, still have to
+		// finish before the log they add to goes away
+		PerfLogTimer timer("Waiting for samples");
+		for (const auto& sample : samples)
+		{
+			sample.wait();
+		}
+	}
+	decodeLog.end();
+
 	// quirk for fixing projects with broken positions of Clips inside pattern tracks
 	Engine::patternStore()->fixIncorrectPositions();
 
@@ -32,7 +32,10 @@
 #include <QDomElement>
 #include <QVariant>
 
+#include <algorithm>
+
 #include "AutomationClip.h"
+#include "AutomationRoutingTable.h"
 #include "AutomationTrack.h"
 #include "ConfigManager.h"
 #include "Engine.h"
@@ -46,6 +49,136 @@
 namespace lmms
 {
 
+/*! \brief An immutable interval index over the clips of a track
+ *
+ *  A centered interval tree stored in flat arrays: each node keeps the
+ *  clips containing its center, sorted by start and by end, while clips
+ *  ending before or starting after it go into its left or right subtree.
+ *  Since every center is the start of one of the node's clips, each node
+ *  visited inside a range reports at least one clip, so a query costs
+ *  O(log n + k) for k clips in the range.
+ */
+class Track::ClipIndex
+{
+public:
+	explicit ClipIndex( const clipVector & clips )
+	{
+		std::vector<Entry> entries;
+		entries.reserve( clips.size() );
+		for( Clip* clip : clips )
+		{
+			entries.push_back( { clip->startPosition(), clip->endPosition(), clip } );
+		}
+		m_byStart.reserve( entries.size() );
+		m_byEnd.reserve( entries.size() );
+		m_root = build( std::move( entries ) );
+	}
+
+	//! Appends all clips intersecting [start, end] to clipV, in no particular order
+	void query( clipVector & clipV, int start, int end ) const
+	{
+		query( m_root, clipV, start, end );
+	}
+
+private:
+	struct Entry
+	{
+		int start;
+		int end;
+		Clip* clip;
+	} ;
+
+	struct Node
+	{
+		int center;
+		int left;
+		int right;
+		std::size_t begin; // range of the node's clips in m_byStart and m_byEnd
+		std::size_t end;
+	} ;
+
+	int build( std::vector<Entry> entries )
+	{
+		if( entries.empty() )
+		{
+			return -1;
+		}
+
+		const auto median = entries.begin() + entries.size() / 2;
+		std::nth_element( entries.begin(), median, entries.end(),
+			[]( const Entry & a, const Entry & b ) { return a.start < b.start; } );
+		const int center = median->start;
+
+		std::vector<Entry> left;
+		std::vector<Entry> right;
+		const std::size_t begin = m_byStart.size();
+		for( const Entry & entry : entries )
+		{
+			if( entry.end < center ) { left.push_back( entry ); }
+			else if( entry.start > center ) { right.push_back( entry ); }
+			else
+			{
+				m_byStart.push_back( entry );
+				m_byEnd.push_back( entry );
+			}
+		}
+		std::sort( m_byStart.begin() + begin, m_byStart.end(),
+			[]( const Entry & a, const Entry & b ) { return a.start < b.start; } );
+		std::sort( m_byEnd.begin() + begin, m_byEnd.end(),
+			[]( const Entry & a, const Entry & b ) { return a.end > b.end; } );
+
+		const int node = m_nodes.size();
+		m_nodes.push_back( { center, -1, -1, begin, m_byStart.size() } );
+		const int leftNode = build( std::move( left ) );
+		const int rightNode = build( std::move( right ) );
+		m_nodes[node].left = leftNode;
+		m_nodes[node].right = rightNode;
+		return node;
+	}
+
+	void query( int node, clipVector & clipV, int start, int end ) const
+	{
+		while( node >= 0 )
+		{
+			const Node & n = m_nodes[node];
+			if( end < n.center )
+			{
+				// the range lies left of the center, so only the start matters
+				for( auto it = m_byStart.begin() + n.begin; it != m_byStart.begin() + n.end && it->start <= end; ++it )
+				{
+					clipV.push_back( it->clip );
+				}
+				node = n.left;
+			}
+			else if( start > n.center )
+			{
+				for( auto it = m_byEnd.begin() + n.begin; it != m_byEnd.begin() + n.end && it->end >= start; ++it )
+				{
+					clipV.push_back( it->clip );
+				}
+				node = n.right;
+			}
+			else
+			{
+				for( auto it = m_byStart.begin() + n.begin; it != m_byStart.begin() + n.end; ++it )
+				{
+					clipV.push_back( it->clip );
+				}
+				query( n.left, clipV, start, end );
+				node = n.right;
+			}
+		}
+	}
+
+	std::vector<Node> m_nodes;
+	std::vector<Entry> m_byStart;
+	std::vector<Entry> m_byEnd;
+	int m_root;
+} ;
+
+
+
+
 /*! \brief Create a new (empty) track object
  *
  *  The track object is the whole track, linking its contents, its
@@ -64,7 +197,8 @@ Track::Track( Type type, TrackContainer * tc ) :
 	m_mutedModel( false, this, tr( "Mute" ) ), /*!< For controlling track muting */
 	m_soloModel( false, this, tr( "Solo" ) ), /*!< For controlling track soloing */
 	m_simpleSerializingMode( false ),
-	m_clips()        /*!< The clips (segments) */
+	m_clips(),       /*!< The clips (segments) */
+	m_clipIndex( std::make_shared<const ClipIndex>( m_clips ) )
 {	
 	m_trackContainer->addTrack( this );
 	m_height = -1;
@@ -326,6 +460,7 @@ void Track::loadSettings( const QDomElement & element )
 Clip * Track::addClip( Clip * clip )
 {
 	m_clips.push_back( clip );
+	clipBoundsChanged();
 
 	emit clipAdded( clip );
 
@@ -345,6 +480,7 @@ void Track::removeClip( Clip * clip )
 	if( it != m_clips.end() )
 	{
 		m_clips.erase( it );
+		clipBoundsChanged();
 		if( Engine::getSong() )
 		{
 			Engine::getSong()->updateLength();
@@ -354,6 +490,16 @@ void Track::removeClip( Clip * clip )
 }
 
 
+void Track::clipBoundsChanged()
+{
+	std::atomic_store( &m_clipIndex, std::make_shared<const ClipIndex>( m_clips ) );
+	// the order of the clips decides which automation clip wins
+	AutomationRoutingTable::invalidate();
+}
+
+
+
+
 /*! \brief Remove all Clips from this track */
 void Track::deleteClips()
 {
@@ -433,6 +579,8 @@ int Track::getClipNum( const Clip * clip )
  *  the given time period.
  *
  *  We return the Clips we find in order by time, earliest Clips first.
+ *  The lookup uses ClipIndex, so it costs O(log n + k) for k clips in
+ *  the range, and never blocks, so the audio thread may call it.
  *
  *  \param clipV The list to contain the found clips.
  *  \param start The MIDI start time of the range.
@@ -441,17 +589,13 @@ int Track::getClipNum( const Clip * clip )
 void Track::getClipsInRange( clipVector & clipV, const TimePos & start,
 							const TimePos & end )
 {
-	for( Clip* clip : m_clips )
+	const auto first = clipV.size();
+	std::atomic_load( &m_clipIndex )->query( clipV, start, end );
+
+	// Insert sorted by Clip's position, without allocating
+	for( auto it = clipV.begin() + first; it != clipV.end(); ++it )
 	{
-		int s = clip->startPosition();
-		int e = clip->endPosition();
-		if( ( s <= end ) && ( e >= start ) )
-		{
-			// Clip is within given range
-			// Insert sorted by Clip's position
-			clipV.insert(std::upper_bound(clipV.begin(), clipV.end(), clip, Clip::comparePosition),
-						clip);
-		}
+		std::rotate( std::upper_bound( clipV.begin(), it, *it, Clip::comparePosition ), it, it + 1 );
 	}
 }
 
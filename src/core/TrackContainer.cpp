@@ -30,6 +30,7 @@
 #include <QWriteLocker>
 
 #include "AutomationClip.h"
+#include "AutomationRoutingTable.h"
 #include "embed.h"
 #include "TrackContainer.h"
 #include "PatternClip.h"
@@ -183,6 +184,7 @@ void TrackContainer::addTrack( Track * _track )
 		m_tracks.push_back( _track );
 		m_tracksMutex.unlock();
 		_track->unlock();
+		AutomationRoutingTable::invalidate();
 		emit trackAdded( _track );
 	}
 }
@@ -205,6 +207,7 @@ void TrackContainer::removeTrack( Track * _track )
 		}
 		m_tracks.erase(it);
 		lockTracksAccess.unlock();
+		AutomationRoutingTable::invalidate();
 
 		if( Engine::getSong() )
 		{
@@ -0,0 +1,183 @@
+/*
+ * AudioEncoderThread.cpp - encodes audio into a file on a separate thread
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "AudioEncoderThread.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "AudioFileDevice.h"
+
+namespace lmms
+{
+
+AudioEncoderThread::AudioEncoderThread(AudioFileDevice* device, PerfLogAccumulator* encodeLog,
+		f_cnt_t capacity) :
+	m_device(device),
+	m_encodeLog(encodeLog),
+	m_ring(capacity),
+	m_readIndex(0),
+	m_writeIndex(0),
+	m_finishing(false),
+	m_producerWaiting(false),
+	m_consumerWaiting(false)
+{
+	start(
+#ifndef LMMS_BUILD_WIN32
+		QThread::HighPriority
+#endif
+	);
+}
+
+
+
+
+AudioEncoderThread::~AudioEncoderThread()
+{
+	finish();
+}
+
+
+
+
+f_cnt_t AudioEncoderThread::readSpace() const
+{
+	// sequentially consistent, this is what the wake-up protocol relies on
+	return m_writeIndex.load() - m_readIndex.load(std::memory_order_relaxed);
+}
+
+
+
+
+f_cnt_t AudioEncoderThread::writeSpace() const
+{
+	return m_ring.size() - (m_writeIndex.load(std::memory_order_relaxed) - m_readIndex.load());
+}
+
+
+
+
+void AudioEncoderThread::write(const SampleFrame* frames, f_cnt_t count)
+{
+	while (count > 0)
+	{
+		f_cnt_t space = writeSpace();
+		if (space == 0)
+		{
+			// announce that we are waiting before checking again, so that
+			// either we see the consumer's progress or it sees the flag
+			QMutexLocker lock(&m_waitMutex);
+			m_producerWaiting = true;
+			while ((space = writeSpace()) == 0)
+			{
+				m_spaceAvailable.wait(&m_waitMutex);
+			}
+			m_producerWaiting = false;
+		}
+
+		const f_cnt_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		const f_cnt_t offset = writeIndex % m_ring.size();
+		const f_cnt_t chunk = std::min({count, space, m_ring.size() - offset});
+		std::memcpy(m_ring.data() + offset, frames, chunk * sizeof(SampleFrame));
+
+		m_writeIndex.store(writeIndex + chunk, std::memory_order_seq_cst);
+		if (m_consumerWaiting.load(std::memory_order_seq_cst))
+		{
+			QMutexLocker lock(&m_waitMutex);
+			m_dataAvailable.wakeAll();
+		}
+
+		frames += chunk;
+		count -= chunk;
+	}
+}
+
+
+
+
+void AudioEncoderThread::finish()
+{
+	if (!isRunning())
+	{
+		return;
+	}
+
+	{
+		QMutexLocker lock(&m_waitMutex);
+		m_finishing = true;
+		m_dataAvailable.wakeAll();
+	}
+	wait();
+}
+
+
+
+
+void AudioEncoderThread::run()
+{
+	// hand at most a quarter of the ring to the device at once, so the
+	// producer can keep going while a batch is being encoded
+	const f_cnt_t maxBatch = std::max<f_cnt_t>(m_ring.size() / 4, 1);
+
+	while (true)
+	{
+		f_cnt_t available = readSpace();
+		if (available == 0)
+		{
+			QMutexLocker lock(&m_waitMutex);
+			m_consumerWaiting = true;
+			while ((available = readSpace()) == 0 && !m_finishing)
+			{
+				m_dataAvailable.wait(&m_waitMutex);
+			}
+			m_consumerWaiting = false;
+
+			if (available == 0)
+			{
+				// finishing and everything has been encoded
+				return;
+			}
+		}
+
+		const f_cnt_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+		const f_cnt_t offset = readIndex % m_ring.size();
+		const f_cnt_t batch = std::min({available, maxBatch, m_ring.size() - offset});
+
+		const auto start = PerfLogAccumulator::Clock::now();
+		m_device->write(m_ring.data() + offset, batch);
+		if (m_encodeLog)
+		{
+			m_encodeLog->add(PerfLogAccumulator::Clock::now() - start);
+		}
+
+		m_readIndex.store(readIndex + batch, std::memory_order_seq_cst);
+		if (m_producerWaiting.load(std::memory_order_seq_cst))
+		{
+			QMutexLocker lock(&m_waitMutex);
+			m_spaceAvailable.wakeAll();
+		}
+	}
+}
+
+} // namespace lmms
@@ -96,7 +96,8 @@ void AudioFileFlac::writeBuffer(const SampleFrame* _ab, fpp_t const frames)
 
 	if (depth == OutputSettings::BitDepth::Depth24Bit || depth == OutputSettings::BitDepth::Depth32Bit) // Float encoding
 	{
-		auto buf = std::vector<sample_t>(frames * channels());
+		auto& buf = m_floatBuffer;
+		buf.resize(frames * channels());
 		for(fpp_t frame = 0; frame < frames; ++frame)
 		{
 			for(ch_cnt_t channel=0; channel<channels(); ++channel)
@@ -111,7 +112,8 @@ void AudioFileFlac::writeBuffer(const SampleFrame* _ab, fpp_t const frames)
 	}
 	else // integer PCM encoding
 	{
-		auto buf = std::vector<int_sample_t>(frames * channels());
+		auto& buf = m_intBuffer;
+		buf.resize(frames * channels());
 		convertToS16(_ab, frames, buf.data(), !isLittleEndian());
 		sf_writef_short(m_sf, static_cast<short*>(buf.data()), frames);
 	}
@@ -62,7 +62,8 @@ void AudioFileMP3::writeBuffer(const SampleFrame* _buf, const fpp_t _frames)
 		return;
 	}
 
-	std::vector<float> interleavedDataBuffer(_frames * 2);
+	auto& interleavedDataBuffer = m_interleavedDataBuffer;
+	interleavedDataBuffer.resize(_frames * 2);
 	for (fpp_t i = 0; i < _frames; ++i)
 	{
 		interleavedDataBuffer[2*i] = _buf[i][0];
@@ -70,7 +71,8 @@ void AudioFileMP3::writeBuffer(const SampleFrame* _buf, const fpp_t _frames)
 	}
 
 	size_t minimumBufferSize = 1.25 * _frames + 7200;
-	std::vector<unsigned char> encodingBuffer(minimumBufferSize);
+	auto& encodingBuffer = m_encodingBuffer;
+	encodingBuffer.resize(minimumBufferSize);
 
 	int bytesWritten = lame_encode_buffer_interleaved_ieee_float(m_lame, &interleavedDataBuffer[0], _frames, &encodingBuffer[0], static_cast<int>(encodingBuffer.size()));
 	assert (bytesWritten >= 0);
@@ -99,7 +99,8 @@ void AudioFileWave::writeBuffer(const SampleFrame* _ab, const fpp_t _frames)
 
 	if( bitDepth == OutputSettings::BitDepth::Depth32Bit || bitDepth == OutputSettings::BitDepth::Depth24Bit )
 	{
-		auto buf = new float[_frames * channels()];
+		m_floatBuffer.resize( _frames * channels() );
+		float * buf = m_floatBuffer.data();
 		for( fpp_t frame = 0; frame < _frames; ++frame )
 		{
 			for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
@@ -108,15 +109,13 @@ void AudioFileWave::writeBuffer(const SampleFrame* _ab, const fpp_t _frames)
 			}
 		}
 		sf_writef_float( m_sf, buf, _frames );
-		delete[] buf;
 	}
 	else
 	{
-		auto buf = new int_sample_t[_frames * channels()];
-		convertToS16(_ab, _frames, buf, !isLittleEndian());
+		m_intBuffer.resize( _frames * channels() );
+		convertToS16(_ab, _frames, m_intBuffer.data(), !isLittleEndian());
 
-		sf_writef_short( m_sf, buf, _frames );
-		delete[] buf;
+		sf_writef_short( m_sf, m_intBuffer.data(), _frames );
 	}
 }
 
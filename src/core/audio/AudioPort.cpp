@@ -24,6 +24,7 @@
 
 #include "AudioPort.h"
 #include "AudioDevice.h"
+#include "AudioEncoderThread.h"
 #include "AudioEngine.h"
 #include "EffectChain.h"
 #include "Mixer.h"
@@ -38,6 +39,7 @@ AudioPort::AudioPort( const QString & _name, bool _has_effect_chain,
 		FloatModel * volumeModel, FloatModel * panningModel,
 		BoolModel * mutedModel ) :
 	m_bufferUsage( false ),
+	m_hasOutput( false ),
 	m_portBuffer( BufferManager::acquire() ),
 	m_extOutputEnabled( false ),
 	m_nextMixerChannel( 0 ),
@@ -45,7 +47,8 @@ AudioPort::AudioPort( const QString & _name, bool _has_effect_chain,
 	m_effects( _has_effect_chain ? new EffectChain( nullptr ) : nullptr ),
 	m_volumeModel( volumeModel ),
 	m_panningModel( panningModel ),
-	m_mutedModel( mutedModel )
+	m_mutedModel( mutedModel ),
+	m_tap( nullptr )
 {
 	Engine::audioEngine()->addAudioPort( this );
 	setExtOutputEnabled( true );
@@ -105,13 +108,21 @@ bool AudioPort::processEffects()
 
 void AudioPort::doProcessing()
 {
+	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
+
+	m_hasOutput = false;
+
 	if( m_mutedModel && m_mutedModel->value() )
 	{
+		if( m_tap )
+		{
+			// keep the tapped output in sync with the song
+			BufferManager::clear( m_portBuffer, fpp );
+			m_tap->write( m_portBuffer, fpp );
+		}
 		return;
 	}
 
-	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
-
 	// clear the buffer
 	BufferManager::clear( m_portBuffer, fpp );
 
@@ -224,10 +235,15 @@ void AudioPort::doProcessing()
 	const bool me = processEffects();
 	if( me || m_bufferUsage )
 	{
-		Engine::mixer()->mixToChannel( m_portBuffer, m_nextMixerChannel ); 	// send output to mixer
-																			// TODO: improve the flow here - convert to pull model
+		// the mixer channel picks up our buffer in Mixer::masterMix()
+		m_hasOutput = true;
 		m_bufferUsage = false;
 	}
+
+	if( m_tap )
+	{
+		m_tap->write( m_portBuffer, fpp );
+	}
 }
 
 
@@ -27,12 +27,40 @@
 #include "fft_helpers.h"
 
 #include <cmath>
+#include <string>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSysInfo>
+
+#include "ConfigManager.h"
 #include "lmms_constants.h"
 
 namespace lmms
 {
 
 
+namespace
+{
+
+//! Wisdom as imported by loadFftwWisdom(), to skip saving unchanged wisdom
+std::string s_loadedWisdom;
+
+// FFTW only rejects wisdom of other FFTW versions. Plans measured on another
+// CPU are accepted but may be slow, so the file is kept per version and host.
+QString wisdomFile()
+{
+	const QByteArray host = QByteArray(fftwf_version) + ' ' + QSysInfo::machineHostName().toUtf8()
+		+ ' ' + QSysInfo::currentCpuArchitecture().toUtf8();
+	const QByteArray id = QCryptographicHash::hash(host, QCryptographicHash::Sha1).toHex().left(12);
+	return ConfigManager::inst()->cacheDir() + "fftw-wisdom-" + QString::fromLatin1(id);
+}
+
+} // namespace
+
+
 /* Returns biggest value from abs_spectrum[spec_size] array.
  *
  * return -1 on error, otherwise the maximum value
@@ -218,4 +246,36 @@ int compressbands(const float *absspec_buffer, float *compressedband, int num_ol
 }
 
 
+void loadFftwWisdom()
+{
+	QFile file(wisdomFile());
+	if (!file.open(QIODevice::ReadOnly)) { return; }
+
+	const QByteArray wisdom = file.readAll();
+	if (fftwf_import_wisdom_from_string(wisdom.constData()))
+	{
+		s_loadedWisdom = wisdom.toStdString();
+	}
+}
+
+
+void saveFftwWisdom()
+{
+	std::string wisdom;
+	fftwf_export_wisdom([](char c, void* data) {
+		static_cast<std::string*>(data)->push_back(c);
+	}, &wisdom);
+	if (wisdom == s_loadedWisdom) { return; }
+
+	const QString fileName = wisdomFile();
+	QDir().mkpath(QFileInfo(fileName).absolutePath());
+	QSaveFile file(fileName);
+	if (file.open(QIODevice::WriteOnly))
+	{
+		file.write(wisdom.data(), wisdom.size());
+		if (file.commit()) { s_loadedWisdom = wisdom; }
+	}
+}
+
+
 } // namespace lmms
@@ -32,8 +32,11 @@
 #include <lv2/buf-size/buf-size.h>
 #include <lv2/options/options.h>
 #include <lv2/worker/worker.h>
+#include <QDateTime>
 #include <QDebug>
+#include <QDirIterator>
 #include <QElapsedTimer>
+#include <QFileInfo>
 
 #include "AudioEngine.h"
 #include "ConfigManager.h"
@@ -41,6 +44,7 @@
 #include "Plugin.h"
 #include "Lv2ControlBase.h"
 #include "Lv2Options.h"
+#include "PluginCache.h"
 #include "PluginIssue.h"
 
 
@@ -234,6 +238,23 @@ const LilvPlugin *Lv2Manager::getPlugin(const QString &uri)
 
 
 
+//! Newest modification time of a bundle directory and its data files, in ms
+//! since epoch. The directory itself changes when files are added or removed.
+static qint64 bundleModificationTime(const QString& bundle)
+{
+	qint64 newest = QFileInfo(bundle).lastModified().toMSecsSinceEpoch();
+	QDirIterator it(bundle, {"*.ttl"}, QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext())
+	{
+		it.next();
+		newest = std::max(newest, it.fileInfo().lastModified().toMSecsSinceEpoch());
+	}
+	return newest;
+}
+
+
+
+
 void Lv2Manager::initPlugins()
 {
 	const LilvPlugins* plugins = lilv_world_get_all_plugins(m_world);
@@ -241,40 +262,77 @@ void Lv2Manager::initPlugins()
 	QElapsedTimer timer;
 	timer.start();
 
+	// Checking a plugin makes lilv parse all of its data files. The results
+	// are cached per plugin library and its bundle's data files, and they
+	// also depend on these settings:
+	PluginCache cache("lv2", QString("blocked=%1 smallbuffers=%2")
+		.arg(ConfigManager::enableBlockedPlugins())
+		.arg(Engine::audioEngine()->framesPerPeriod() <= 32));
+	std::map<QString, QVariantMap> libraries;
+	std::map<QString, qint64> bundles; // modification times
+
 	unsigned blocked = 0;
 	LILV_FOREACH(plugins, itr, plugins)
 	{
 		const LilvPlugin* curPlug = lilv_plugins_get(plugins, itr);
+		const char* uri = lilv_node_as_uri(lilv_plugin_get_uri(curPlug));
 
-		std::vector<PluginIssue> issues;
-		Plugin::Type type = Lv2ControlBase::check(curPlug, issues);
-		std::sort(issues.begin(), issues.end());
-		auto last = std::unique(issues.begin(), issues.end());
-		issues.erase(last, issues.end());
-		if (m_debug && issues.size())
+		QFileInfo library;
+		if (const LilvNode* libraryUri = lilv_plugin_get_library_uri(curPlug))
 		{
-			qDebug() << "Lv2 plugin"
-				<< qStringFromPluginNode(curPlug, lilv_plugin_get_name)
-				<< "(URI:"
-				<< lilv_node_as_uri(lilv_plugin_get_uri(curPlug))
-				<< ") can not be loaded:";
-			for (const PluginIssue& iss : issues) { qDebug() << "  - " << iss; }
+			char* libraryPath = lilv_file_uri_parse(lilv_node_as_uri(libraryUri), nullptr);
+			library.setFile(QString::fromLocal8Bit(libraryPath));
+			lilv_free(libraryPath);
 		}
 
-		Lv2Info info(curPlug, type, issues.empty());
+		qint64 bundleModified = 0;
+		if (char* bundlePath = lilv_file_uri_parse(lilv_node_as_uri(lilv_plugin_get_bundle_uri(curPlug)), nullptr))
+		{
+			const auto bundle = QString::fromLocal8Bit(bundlePath);
+			lilv_free(bundlePath);
+			auto [modified, unscanned] = bundles.try_emplace(bundle);
+			if (unscanned) { modified->second = bundleModificationTime(bundle); }
+			bundleModified = modified->second;
+		}
 
-		m_lv2InfoMap[lilv_node_as_uri(lilv_plugin_get_uri(curPlug))]
-			= std::move(info);
-		if(issues.empty()) { ++pluginsLoaded; }
-		else
+		// [type, valid, blocked]
+		QVariantList result;
+		auto [cached, uncached] = libraries.try_emplace(library.absoluteFilePath());
+		if (uncached) { cache.lookup(library, cached->second, bundleModified); }
+		// in debug mode, all checks are done again to print the issues
+		if (!m_debug) { result = cached->second.value(uri).toList(); }
+
+		if (result.size() != 3)
 		{
-			if(std::any_of(issues.begin(), issues.end(),
-				[](const PluginIssue& iss) {
-				return iss.type() == PluginIssueType::Blocked; }))
+			std::vector<PluginIssue> issues;
+			Plugin::Type type = Lv2ControlBase::check(curPlug, issues);
+			std::sort(issues.begin(), issues.end());
+			auto last = std::unique(issues.begin(), issues.end());
+			issues.erase(last, issues.end());
+			if (m_debug && issues.size())
 			{
-				++blocked;
+				qDebug() << "Lv2 plugin"
+					<< qStringFromPluginNode(curPlug, lilv_plugin_get_name)
+					<< "(URI:"
+					<< uri
+					<< ") can not be loaded:";
+				for (const PluginIssue& iss : issues) { qDebug() << "  - " << iss; }
 			}
+
+			result = {static_cast<int>(type), issues.empty(),
+				std::any_of(issues.begin(), issues.end(),
+					[](const PluginIssue& iss) {
+					return iss.type() == PluginIssueType::Blocked; })};
+			cached->second.insert(uri, result);
+			if (library.isFile()) { cache.insert(library, cached->second, bundleModified); }
 		}
+
+		const bool valid = result[1].toBool();
+		Lv2Info info(curPlug, static_cast<Plugin::Type>(result[0].toInt()), valid);
+
+		m_lv2InfoMap[uri] = std::move(info);
+		if(valid) { ++pluginsLoaded; }
+		else if(result[2].toBool()) { ++blocked; }
 		++pluginCount;
 	}
 
@@ -62,7 +62,10 @@
 #include <csignal>
 
 #include "MainApplication.h"
+#include "AutomationClip.h"
+#include "BatchRenderer.h"
 #include "ConfigManager.h"
+#include "ControllerConnection.h"
 #include "DataFile.h"
 #include "NotePlayHandle.h"
 #include "embed.h"
@@ -72,6 +75,7 @@
 #include "MainWindow.h"
 #include "MixHelpers.h"
 #include "OutputSettings.h"
+#include "PluginCache.h"
 #include "ProjectRenderer.h"
 #include "RenderManager.h"
 #include "Song.h"
@@ -169,6 +173,10 @@ void printHelp()
 		"  compress <in>                         Compress file <in>\n"
 		"  render <project> [options...]         Render given project file\n"
 		"  rendertracks <project> [options...]   Render each track to a different file\n"
+		"  render --batch <jobs> [options...]    Render all projects listed in <jobs>\n"
+		"  rendertracks --batch <jobs> [options...]\n"
+		"                                        Render the tracks of all projects\n"
+		"                                        listed in <jobs>\n"
 		"  upgrade <in> [out]                    Upgrade file <in> and save as <out>\n"
 		"                                        Standard out is used if no output file\n"
 		"                                        is specified\n"
@@ -180,6 +188,8 @@ void printHelp()
 		"          caution).\n"
 		"  -c, --config <configfile>      Get the configuration from <configfile>\n"
 		"  -h, --help                     Show this usage information and exit.\n"
+		"      --rescan-plugins           Load all plugin libraries instead of\n"
+		"          relying on what the previous scan found out.\n"
 		"  -v, --version                  Show version information and exit.\n"
 		"\nOptions if no action is given:\n"
 		"      --geometry <geometry>      Specify the size and position of\n"
@@ -191,6 +201,14 @@ void printHelp()
 		"  -a, --float                    Use 32bit float bit depth\n"
 		"  -b, --bitrate <bitrate>        Specify output bitrate in KBit/s\n"
 		"          Default: 160.\n"
+		"      --blocksize <frames>       Render in blocks of <frames> frames\n"
+		"          Range: 256 (default) to 4096\n"
+		"          Larger blocks render faster. Projects using automation\n"
+		"          or controllers are rendered with the default block size.\n"
+		"      --batch <jobs>             Render one project after another without\n"
+		"          restarting. <jobs> lists one project file per line,\n"
+		"          optionally followed by a tab and the output path.\n"
+		"          Empty lines and lines starting with # are ignored.\n"
 		"  -f, --format <format>         Specify format of render-output where\n"
 		"          Format is either 'wav', 'flac', 'ogg' or 'mp3'.\n"
 		"  -i, --interpolation <method>   Specify interpolation method\n"
@@ -212,6 +230,10 @@ void printHelp()
 		"          If not specified, render will overwrite the input file\n"
 		"          For \"rendertracks\", this might be required\n"
 		"  -p, --profile <out>            Dump profiling information to file <out>\n"
+		"      --stems                    For \"rendertracks\", render the song only\n"
+		"          once and take each track's output before the mixer.\n"
+		"          Mixer effects are not applied to the tracks, the\n"
+		"          master output is written to 0_Master as well.\n"
 		"  -s, --samplerate <samplerate>  Specify output samplerate in Hz\n"
 		"          Range: 44100 (default) to 192000\n"
 		"          Possible values: 1, 2, 4, 8\n"
@@ -240,6 +262,50 @@ void fileCheck( QString &file )
 	}
 }
 
+
+
+
+// Instruments and effects only see automated and controlled values at the
+// end of each render block, so larger blocks would move them in audible
+// steps. Projects using either are rendered with the default block size.
+fpp_t renderBlockSizeFor( fpp_t blockSize, const QStringList& projects )
+{
+	using namespace lmms;
+
+	if( blockSize <= DEFAULT_BUFFER_SIZE )
+	{
+		return blockSize;
+	}
+
+	for( const QString& project : projects )
+	{
+		if( !QFileInfo( project ).isFile() )
+		{
+			continue;
+		}
+
+		const DataFile dataFile( project );
+		const QDomNodeList clips = dataFile.elementsByTagName( AutomationClip::classNodeName() );
+		bool automated = dataFile.elementsByTagName( ControllerConnection::classNodeName() ).count() > 0;
+		for( int i = 0; !automated && i < clips.count(); ++i )
+		{
+			automated = !clips.at( i ).toElement().elementsByTagName( "object" ).isEmpty();
+		}
+
+		if( automated )
+		{
+			printf( "%s uses automation or controllers, rendering in blocks of %zu frames\n",
+				project.toUtf8().constData(), DEFAULT_BUFFER_SIZE );
+			return DEFAULT_BUFFER_SIZE;
+		}
+	}
+
+	return blockSize;
+}
+
+
+
+
 int usageError(const QString& message)
 {
 	qCritical().noquote() << QString("\n%1.\n\nTry \"%2 --help\" for more information.\n\n")
@@ -320,6 +386,9 @@ int main( int argc, char * * argv )
 	bool allowRoot = false;
 	bool renderLoop = false;
 	bool renderTracks = false;
+	bool renderStems = false;
+	fpp_t renderBlockSize = 0;
+	QString batchFile;
 	QString fileToLoad, fileToImport, renderOut, profilerOutputFile, configFile;
 
 	// first of two command-line parsing stages
@@ -450,6 +519,10 @@ int main( int argc, char * * argv )
 #endif
 
 		}
+		else if( arg == "--rescan-plugins" )
+		{
+			PluginCache::setRescan( true );
+		}
 		else if( arg == "dump" || arg == "--dump" || arg  == "-d" )
 		{
 			++i;
@@ -486,6 +559,12 @@ int main( int argc, char * * argv )
 		else if( arg == "render" || arg == "--render" || arg == "-r" ||
 			arg == "rendertracks" || arg == "--rendertracks" )
 		{
+			// when rendering a batch, the projects are listed in the job file
+			if( i + 1 < argc && QString( argv[i + 1] ) == "--batch" )
+			{
+				continue;
+			}
+
 			++i;
 
 			if( i == argc )
@@ -501,6 +580,42 @@ int main( int argc, char * * argv )
 		{
 			renderLoop = true;
 		}
+		else if( arg == "--stems" )
+		{
+			renderStems = true;
+		}
+		else if( arg == "--batch" )
+		{
+			++i;
+
+			if( i == argc )
+			{
+				return usageError( "No job file specified" );
+			}
+
+
+			batchFile = QString::fromLocal8Bit( argv[i] );
+		}
+		else if( arg == "--blocksize" )
+		{
+			++i;
+
+			if( i == argc )
+			{
+				return usageError( "No block size specified" );
+			}
+
+
+			const fpp_t blockSize = QString( argv[i] ).toUInt();
+			if( blockSize >= DEFAULT_BUFFER_SIZE && blockSize <= MAXIMUM_RENDER_BUFFER_SIZE )
+			{
+				renderBlockSize = blockSize;
+			}
+			else
+			{
+				return usageError( QString( "Invalid block size %1" ).arg( argv[i] ) );
+			}
+		}
 		else if( arg == "--output" || arg == "-o" )
 		{
 			++i;
@@ -782,11 +897,44 @@ int main( int argc, char * * argv )
 
 	bool destroyEngine = false;
 
+	// render all projects of a batch with the same engine
+	// without starting the GUI
+	if( !batchFile.isEmpty() )
+	{
+		const auto mode = !renderTracks ? BatchRenderer::Mode::Project
+			: renderStems ? BatchRenderer::Mode::Stems
+			: BatchRenderer::Mode::Tracks;
+		auto batch = new BatchRenderer(qs, os, eff, mode, renderLoop);
+		if( !batch->loadJobs( batchFile ) )
+		{
+			printf( "Could not read job file %s\n", batchFile.toUtf8().constData() );
+			exit( EXIT_FAILURE );
+		}
+		printf( "Rendering %zu projects\n", batch->numJobs() );
+
+		// all jobs share the engine and with it the block size
+		Engine::init( true, renderBlockSizeFor( renderBlockSize, batch->projects() ) );
+		destroyEngine = true;
+
+		QObject::connect( batch, &BatchRenderer::finished, [batch]()
+		{
+			QCoreApplication::exit( batch->failedJobs() > 0 ? EXIT_FAILURE : EXIT_SUCCESS );
+		} );
+
+		if( profilerOutputFile.isEmpty() == false )
+		{
+			Engine::audioEngine()->profiler().setOutputFile( profilerOutputFile );
+		}
+
+		// start once the event loop is running, so that finishing right
+		// away (e.g. an empty job file) still ends the application
+		QTimer::singleShot( 0, batch, SLOT(start()) );
+	}
 	// if we have an output file for rendering, just render the song
 	// without starting the GUI
-	if( !renderOut.isEmpty() )
+	else if( !renderOut.isEmpty() )
 	{
-		Engine::init( true );
+		Engine::init( true, renderBlockSizeFor( renderBlockSize, { fileToLoad } ) );
 		destroyEngine = true;
 
 		printf( "Loading project...\n" );
@@ -810,8 +958,10 @@ int main( int argc, char * * argv )
 
 		// create renderer
 		auto r = new RenderManager(qs, os, eff, renderOut);
-		QCoreApplication::instance()->connect( r,
-				SIGNAL(finished()), SLOT(quit()));
+		QObject::connect( r, &RenderManager::finished, [r]()
+		{
+			QCoreApplication::exit( r->failedRenders() > 0 ? EXIT_FAILURE : EXIT_SUCCESS );
+		} );
 
 		// timer for progress-updates
 		auto t = new QTimer(r);
@@ -825,7 +975,11 @@ int main( int argc, char * * argv )
 		}
 
 		// start now!
-		if ( renderTracks )
+		if ( renderTracks && renderStems )
+		{
+			r->renderStems();
+		}
+		else if ( renderTracks )
 		{
 			r->renderTracks();
 		}
@@ -32,6 +32,7 @@
 #include "FileDialog.h"
 #include "GuiApplication.h"
 #include "PathUtil.h"
+#include "SampleCache.h"
 #include "SampleDecoder.h"
 #include "Song.h"
 
@@ -94,7 +95,22 @@ std::shared_ptr<const SampleBuffer> SampleLoader::createBufferFromFile(const QSt
 
 	try
 	{
-		return std::make_shared<SampleBuffer>(filePath);
+		return SampleCache::get(filePath);
+	}
+	catch (const std::runtime_error& error)
+	{
+		if (getGUI()) { displayError(QString::fromStdString(error.what())); }
+		return SampleBuffer::emptyBuffer();
+	}
+}
+
+std::shared_ptr<const SampleBuffer> SampleLoader::createStreamedBufferFromFile(const QString& filePath)
+{
+	if (filePath.isEmpty()) { return SampleBuffer::emptyBuffer(); }
+
+	try
+	{
+		return SampleCache::getStreamed(filePath);
 	}
 	catch (const std::runtime_error& error)
 	{
@@ -26,6 +26,17 @@
 
 namespace lmms::gui {
 
+auto SampleWaveform::parameters(const Sample& sample) -> Parameters
+{
+	const auto buffer = sample.buffer();
+	if (buffer->streamed())
+	{
+		const auto& overview = buffer->overview();
+		return {overview.data(), overview.size(), sample.amplification(), sample.reversed()};
+	}
+	return {buffer->data(), buffer->size(), sample.amplification(), sample.reversed()};
+}
+
 void SampleWaveform::visualize(Parameters parameters, QPainter& painter, const QRect& rect)
 {
 	const int x = rect.x();
@@ -896,6 +896,7 @@ void AutomationEditor::mouseMoveEvent(QMouseEvent * mouseEvent )
 					{
 						it.value().setInTangent(newTangent);
 					}
+					m_clip->compileCurve();
 				}
 				else if (m_mouseDownRight && m_action == Action::ResetTangents)
 				{
@@ -1218,9 +1219,7 @@ void AutomationEditor::paintEvent(QPaintEvent * pe )
 
 			p.setPen(m_ghostSampleColor);
 			
-			const auto& sample = m_ghostSample->sample();
-			const auto waveform = SampleWaveform::Parameters{
-				sample.data(), sample.sampleSize(), sample.amplification(), sample.reversed()};
+			const auto waveform = SampleWaveform::parameters(m_ghostSample->sample());
 			const auto rect = QRect(startPos, yOffset, sampleWidth, sampleHeight);
 			SampleWaveform::visualize(waveform, p, rect);
 		}
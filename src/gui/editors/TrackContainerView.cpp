@@ -31,6 +31,7 @@
 
 #include "TrackContainer.h"
 #include "AudioEngine.h"
+#include "AutomationRoutingTable.h"
 #include "DataFile.h"
 #include "MainWindow.h"
 #include "FileBrowser.h"
@@ -202,6 +203,7 @@ void TrackContainerView::moveTrackView( TrackView * trackView, int indexTo )
 	m_tc->m_tracks.erase(m_tc->m_tracks.begin() + indexFrom);
 	m_tc->m_tracks.insert(m_tc->m_tracks.begin() + indexTo, track);
 	m_trackViews.move( indexFrom, indexTo );
+	AutomationRoutingTable::invalidate();
 
 	realignTracks();
 }
@@ -98,6 +98,9 @@ ExportProjectDialog::ExportProjectDialog( const QString & _file_name,
 	compressionWidget->setVisible(false);
 #endif
 
+	// single pass stem export only makes sense when exporting tracks
+	stemsCB->setVisible( m_multiExport );
+
 	connect( startButton, SIGNAL(clicked()),
 			this, SLOT(startBtnClicked()));
 }
@@ -196,7 +199,11 @@ void ExportProjectDialog::startExport()
 	connect( m_renderManager.get(), SIGNAL(finished()),
 			getGUI()->mainWindow(), SLOT(resetWindowTitle()));
 
-	if ( m_multiExport )
+	if ( m_multiExport && stemsCB->isChecked() )
+	{
+		m_renderManager->renderStems();
+	}
+	else if ( m_multiExport )
 	{
 		m_renderManager->renderTracks();
 	}
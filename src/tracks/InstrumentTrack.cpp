@@ -753,25 +753,10 @@ bool InstrumentTrack::play( const TimePos & _start, const fpp_t _frames,
 			cur_start -= c->startPosition();
 		}
 
-		// get all notes from the given clip...
-		const NoteVector & notes = c->notes();
-		// ...and set our index to zero
-		auto nit = notes.begin();
+		// get all notes starting at the current tick
+		const auto [firstNote, lastNote] = c->notesStartingAt(cur_start);
 
-		// very effective algorithm for playing notes that are
-		// posated within the current sample-frame
-
-
-		if( cur_start > 0 )
-		{
-			// skip notes which are posated before start-bar
-			while( nit != notes.end() && ( *nit )->pos() < cur_start )
-			{
-				++nit;
-			}
-		}
-
-		while (nit != notes.end() && (*nit)->pos() == cur_start)
+		for (auto nit = firstNote; nit != lastNote; ++nit)
 		{
 			const auto currentNote = *nit;
 
@@ -793,7 +778,6 @@ bool InstrumentTrack::play( const TimePos & _start, const fpp_t _frames,
 
 			Engine::audioEngine()->addPlayHandle( notePlayHandle );
 			played_a_note = true;
-			++nit;
 		}
 	}
 	unlock();
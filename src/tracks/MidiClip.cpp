@@ -259,6 +259,35 @@ Note * MidiClip::noteAtStep(int step)
 
 
 
+MidiClip::NoteRange MidiClip::notesStartingAt( const TimePos & pos ) const
+{
+	// how far the cursor may be moved step by step before falling back to a binary search
+	constexpr std::size_t MaxCursorSteps = 8;
+
+	auto cursor = std::min(m_playCursor, m_notes.size());
+	for (std::size_t steps = 0; cursor < m_notes.size() && m_notes[cursor]->pos() < pos
+		&& steps < MaxCursorSteps; ++steps)
+	{
+		++cursor;
+	}
+
+	const bool cursorValid = (cursor == 0 || m_notes[cursor - 1]->pos() < pos)
+		&& (cursor == m_notes.size() || m_notes[cursor]->pos() >= pos);
+	auto first = cursorValid
+		? m_notes.begin() + cursor
+		: std::lower_bound(m_notes.begin(), m_notes.end(), pos,
+			[](const Note* note, const TimePos& p) { return note->pos() < p; });
+
+	auto last = first;
+	while (last != m_notes.end() && (*last)->pos() == pos) { ++last; }
+
+	m_playCursor = static_cast<std::size_t>(first - m_notes.begin());
+	return {first, last};
+}
+
+
+
+
 void MidiClip::rearrangeAllNotes()
 {
 	// sort notes by start time
@@ -439,6 +468,9 @@ void MidiClip::loadSettings( const QDomElement & _this )
 		node = node.nextSibling();
         }
 
+	// notes are expected to be sorted, but don't rely on files written by other tools
+	rearrangeAllNotes();
+
 	m_steps = _this.attribute( "steps" ).toInt();
 	if( m_steps == 0 )
 	{
@@ -0,0 +1,190 @@
+/*
+ * AudioEngineWorkerThreadTest.cpp
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "AudioEngineWorkerThread.h"
+#include "ThreadableJob.h"
+
+using lmms::AudioEngineWorkerThread;
+using Scheduler = AudioEngineWorkerThread::Scheduler;
+using OperationMode = AudioEngineWorkerThread::JobQueue::OperationMode;
+
+Q_DECLARE_METATYPE(Scheduler)
+
+namespace
+{
+
+class CountingJob : public lmms::ThreadableJob
+{
+public:
+	bool requiresProcessing() const override { return true; }
+
+	std::atomic_int processed{0};
+	CountingJob* next = nullptr;
+	float result = 0.f;
+
+protected:
+	void doProcessing() override
+	{
+		++processed;
+		// a little bit of work, roughly the cost of a cheap play handle
+		for (int i = 0; i < 256; ++i) { result += std::sin(static_cast<float>(i)); }
+		// mimic Mixer: finishing a job may make dependent jobs ready
+		if (next) { AudioEngineWorkerThread::addJob(next); }
+	}
+};
+
+//! Starts the worker threads like AudioEngine does and shuts them down again
+class WorkerPool
+{
+public:
+	WorkerPool(Scheduler scheduler, int numWorkers)
+	{
+		AudioEngineWorkerThread::setScheduler(scheduler, numWorkers);
+		for (int i = 0; i < numWorkers + 1; ++i)
+		{
+			auto wt = new AudioEngineWorkerThread(nullptr);
+			if (i < numWorkers) { wt->start(QThread::TimeCriticalPriority); }
+			m_workers.push_back(wt);
+		}
+	}
+
+	~WorkerPool()
+	{
+		for (auto wt : m_workers) { wt->quit(); }
+		for (auto wt : m_workers)
+		{
+			// keep waking the workers until each has seen the quit flag
+			while (!wt->wait(10)) { AudioEngineWorkerThread::startAndWaitForJobs(); }
+			delete wt;
+		}
+	}
+
+private:
+	std::vector<AudioEngineWorkerThread*> m_workers;
+};
+
+int numWorkers()
+{
+	return std::max(1, QThread::idealThreadCount() - 1);
+}
+
+} // namespace
+
+class AudioEngineWorkerThreadTest : public QObject
+{
+	Q_OBJECT
+private:
+	void addSchedulerRows()
+	{
+		QTest::addColumn<Scheduler>("scheduler");
+		QTest::newRow("shared queue") << Scheduler::SharedQueue;
+		QTest::newRow("work stealing") << Scheduler::WorkStealing;
+	}
+
+private slots:
+	void StaticJobsTest_data() { addSchedulerRows(); }
+	void StaticJobsTest()
+	{
+		QFETCH(Scheduler, scheduler);
+		WorkerPool pool(scheduler, numWorkers());
+
+		auto jobs = std::vector<CountingJob>(500);
+		for (int round = 0; round < 20; ++round)
+		{
+			AudioEngineWorkerThread::resetJobQueue();
+			for (auto& job : jobs) { AudioEngineWorkerThread::addJob(&job); }
+			AudioEngineWorkerThread::startAndWaitForJobs();
+		}
+
+		for (const auto& job : jobs)
+		{
+			QCOMPARE(job.processed.load(), 20);
+			QVERIFY(job.state() == lmms::ThreadableJob::ProcessingState::Done);
+		}
+	}
+
+	void DynamicJobsTest_data() { addSchedulerRows(); }
+	void DynamicJobsTest()
+	{
+		QFETCH(Scheduler, scheduler);
+		WorkerPool pool(scheduler, numWorkers());
+
+		// 32 chains of 16 jobs each, only the heads are queued up front
+		constexpr int Chains = 32;
+		constexpr int ChainLength = 16;
+		auto jobs = std::vector<CountingJob>(Chains * ChainLength);
+		for (int c = 0; c < Chains; ++c)
+		{
+			for (int i = 0; i < ChainLength - 1; ++i)
+			{
+				jobs[c * ChainLength + i].next = &jobs[c * ChainLength + i + 1];
+			}
+		}
+
+		AudioEngineWorkerThread::resetJobQueue(OperationMode::Dynamic);
+		for (int c = 0; c < Chains; ++c) { AudioEngineWorkerThread::addJob(&jobs[c * ChainLength]); }
+		AudioEngineWorkerThread::startAndWaitForJobs();
+
+		for (const auto& job : jobs) { QCOMPARE(job.processed.load(), 1); }
+	}
+
+	void SchedulerBenchmark_data()
+	{
+		QTest::addColumn<Scheduler>("scheduler");
+		QTest::addColumn<int>("numJobs");
+		for (int numJobs : {16, 64, 320})
+		{
+			QTest::newRow(qPrintable(QString("shared queue, %1 jobs").arg(numJobs)))
+				<< Scheduler::SharedQueue << numJobs;
+			QTest::newRow(qPrintable(QString("work stealing, %1 jobs").arg(numJobs)))
+				<< Scheduler::WorkStealing << numJobs;
+		}
+	}
+
+	void SchedulerBenchmark()
+	{
+		QFETCH(Scheduler, scheduler);
+		QFETCH(int, numJobs);
+		WorkerPool pool(scheduler, numWorkers());
+
+		auto jobs = std::vector<CountingJob>(numJobs);
+		QBENCHMARK
+		{
+			AudioEngineWorkerThread::resetJobQueue();
+			for (auto& job : jobs) { AudioEngineWorkerThread::addJob(&job); }
+			AudioEngineWorkerThread::startAndWaitForJobs();
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(AudioEngineWorkerThreadTest)
+#include "AudioEngineWorkerThreadTest.moc"
@@ -0,0 +1,221 @@
+/*
+ * MixHelpersTest.cpp
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "MixHelpers.h"
+#include "SampleFrame.h"
+#include "ValueBuffer.h"
+
+using lmms::SampleFrame;
+using lmms::MixHelpers::SimdLevel;
+
+Q_DECLARE_METATYPE(SimdLevel)
+
+namespace
+{
+
+using Kernel = std::function<void(SampleFrame* dst, const SampleFrame* src, lmms::ValueBuffer* coeffs, int frames)>;
+
+const std::vector<std::pair<const char*, Kernel>>& kernels()
+{
+	using namespace lmms::MixHelpers;
+	static const auto s_kernels = std::vector<std::pair<const char*, Kernel>>{
+		{"add", [](auto dst, auto src, auto, int frames) { add(dst, src, frames); }},
+		{"multiply", [](auto dst, auto, auto, int frames) { multiply(dst, 0.999f, frames); }},
+		{"addMultiplied", [](auto dst, auto src, auto, int frames) { addMultiplied(dst, src, 0.5f, frames); }},
+		{"addSwappedMultiplied", [](auto dst, auto src, auto, int frames) {
+			addSwappedMultiplied(dst, src, 0.5f, frames); }},
+		{"addMultipliedStereo", [](auto dst, auto src, auto, int frames) {
+			addMultipliedStereo(dst, src, 0.25f, 0.75f, frames); }},
+		{"multiplyAndAddMultiplied", [](auto dst, auto src, auto, int frames) {
+			multiplyAndAddMultiplied(dst, src, 0.5f, 0.25f, frames); }},
+		{"addMultipliedByBuffer", [](auto dst, auto src, auto coeffs, int frames) {
+			addMultipliedByBuffer(dst, src, 0.5f, coeffs, frames); }},
+		{"addSanitizedMultiplied", [](auto dst, auto src, auto, int frames) {
+			addSanitizedMultiplied(dst, src, 0.5f, frames); }},
+		{"addSanitizedMultipliedByBuffers", [](auto dst, auto src, auto coeffs, int frames) {
+			addSanitizedMultipliedByBuffers(dst, src, coeffs, coeffs, frames); }},
+		{"sanitize", [](auto dst, auto, auto, int frames) { sanitize(dst, frames); }},
+		{"isSilent", [](auto dst, auto, auto, int frames) { isSilent(dst, frames); }},
+	};
+	return s_kernels;
+}
+
+std::vector<SimdLevel> supportedLevels()
+{
+	auto levels = std::vector<SimdLevel>{};
+	for (auto level : {SimdLevel::None, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512, SimdLevel::Neon})
+	{
+		if (lmms::MixHelpers::isSimdLevelSupported(level)) { levels.push_back(level); }
+	}
+	return levels;
+}
+
+const char* levelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Sse2: return "SSE2";
+	case SimdLevel::Avx2: return "AVX2";
+	case SimdLevel::Avx512: return "AVX-512";
+	case SimdLevel::Neon: return "NEON";
+	default: return "scalar";
+	}
+}
+
+} // namespace
+
+class MixHelpersTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase()
+	{
+		m_defaultLevel = lmms::MixHelpers::simdLevel();
+		lmms::MixHelpers::setNaNHandler(true);
+	}
+
+	void cleanup()
+	{
+		lmms::MixHelpers::setSimdLevel(m_defaultLevel);
+	}
+
+	void VectorisedMatchesScalarTest()
+	{
+		using namespace lmms;
+
+		auto random = std::mt19937{42};
+		auto dist = std::uniform_real_distribution<float>{-2.f, 2.f};
+
+		// odd sizes exercise the scalar tails of the vector loops
+		for (int frames : {1, 3, 8, 17, 256, 259})
+		{
+			auto src = std::vector<SampleFrame>(frames);
+			auto dst = std::vector<SampleFrame>(frames);
+			auto coeffs = ValueBuffer(frames);
+			for (auto& frame : src) { frame = SampleFrame(dist(random), dist(random)); }
+			for (auto& frame : dst) { frame = SampleFrame(dist(random), dist(random)); }
+			for (int f = 0; f < frames; ++f) { coeffs.values()[f] = dist(random); }
+			if (frames > 3)
+			{
+				src[1].setLeft(INFINITY);
+				src[2].setRight(NAN);
+			}
+
+			for (const auto& [name, kernel] : kernels())
+			{
+				auto expected = dst;
+				MixHelpers::setSimdLevel(SimdLevel::None);
+				kernel(expected.data(), src.data(), &coeffs, frames);
+
+				for (auto level : supportedLevels())
+				{
+					auto result = dst;
+					MixHelpers::setSimdLevel(level);
+					kernel(result.data(), src.data(), &coeffs, frames);
+					QVERIFY2(std::memcmp(result.data(), expected.data(), frames * sizeof(SampleFrame)) == 0,
+						qPrintable(QString("%1 (%2, %3 frames)").arg(name).arg(levelName(level)).arg(frames)));
+				}
+			}
+		}
+	}
+
+	void SanitizeTest()
+	{
+		using namespace lmms;
+
+		for (auto level : supportedLevels())
+		{
+			MixHelpers::setSimdLevel(level);
+
+			auto buffer = std::vector<SampleFrame>(259, SampleFrame(2000.f, -0.5f));
+			QVERIFY(!MixHelpers::sanitize(buffer.data(), buffer.size()));
+			QCOMPARE(buffer.back().left(), 1000.f);
+			QCOMPARE(buffer.back().right(), -0.5f);
+			QVERIFY(!MixHelpers::isSilent(buffer.data(), buffer.size()));
+
+			buffer[258].setRight(-INFINITY);
+			QVERIFY(MixHelpers::sanitize(buffer.data(), buffer.size()));
+			QVERIFY(MixHelpers::isSilent(buffer.data(), buffer.size()));
+		}
+	}
+
+	void KernelBenchmark_data()
+	{
+		QTest::addColumn<SimdLevel>("level");
+		QTest::addColumn<int>("kernel");
+		for (auto level : supportedLevels())
+		{
+			for (std::size_t k = 0; k < kernels().size(); ++k)
+			{
+				QTest::newRow(qPrintable(QString("%1, %2").arg(kernels()[k].first).arg(levelName(level))))
+					<< level << static_cast<int>(k);
+			}
+		}
+	}
+
+	void KernelBenchmark()
+	{
+		using namespace lmms;
+		QFETCH(SimdLevel, level);
+		QFETCH(int, kernel);
+
+		// one period at the default buffer size, like a mixer channel processes it
+		constexpr int Frames = 256;
+		constexpr int Iterations = 100000;
+		auto src = std::vector<SampleFrame>(Frames, SampleFrame(0.25f, -0.25f));
+		auto dst = std::vector<SampleFrame>(Frames);
+		auto coeffs = ValueBuffer(Frames);
+		coeffs.fill(0.5f);
+
+		MixHelpers::setSimdLevel(level);
+		const auto& run = kernels()[kernel].second;
+
+		QElapsedTimer timer;
+		timer.start();
+		for (int i = 0; i < Iterations; ++i)
+		{
+			run(dst.data(), src.data(), &coeffs, Frames);
+		}
+		const auto seconds = std::max<qint64>(timer.nsecsElapsed(), 1) / 1e9;
+
+		QTest::setBenchmarkResult(Frames * Iterations / seconds, QTest::FramesPerSecond);
+	}
+
+private:
+	SimdLevel m_defaultLevel;
+};
+
+QTEST_GUILESS_MAIN(MixHelpersTest)
+#include "MixHelpersTest.moc"
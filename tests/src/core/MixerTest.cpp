@@ -0,0 +1,177 @@
+/*
+ * MixerTest.cpp
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "AudioEngine.h"
+#include "AudioEngineWorkerThread.h"
+#include "AudioPort.h"
+#include "Engine.h"
+#include "Mixer.h"
+#include "PlayHandle.h"
+#include "SampleFrame.h"
+
+namespace
+{
+
+using namespace lmms;
+
+//! Plays a constant value, standing in for the play handles of a track
+class ConstantPlayHandle : public PlayHandle
+{
+public:
+	ConstantPlayHandle(AudioPort* port, float value) :
+		PlayHandle(Type::SamplePlayHandle),
+		m_value(value)
+	{
+		setAudioPort(port);
+	}
+
+	void play(SampleFrame* buffer) override
+	{
+		std::fill_n(buffer, Engine::audioEngine()->framesPerPeriod(), SampleFrame{m_value, m_value});
+	}
+
+	bool isFinished() const override { return false; }
+	bool isFromTrack(const Track*) const override { return false; }
+
+private:
+	float m_value;
+};
+
+//! Many audio ports (i.e. tracks) feeding one mixer channel
+class Bus
+{
+public:
+	Bus(int numPorts) :
+		m_channel(Engine::mixer()->createChannel())
+	{
+		for (int i = 0; i < numPorts; ++i)
+		{
+			auto port = std::make_unique<AudioPort>(QString("port %1").arg(i), false);
+			port->setNextMixerChannel(m_channel);
+			auto handle = std::make_unique<ConstantPlayHandle>(port.get(), (i + 1) / 1024.f);
+			port->addPlayHandle(handle.get());
+			m_ports.push_back(std::move(port));
+			m_handles.push_back(std::move(handle));
+		}
+	}
+
+	~Bus()
+	{
+		for (std::size_t i = 0; i < m_ports.size(); ++i)
+		{
+			m_ports[i]->removePlayHandle(m_handles[i].get());
+		}
+		m_handles.clear();
+		m_ports.clear();
+		Engine::mixer()->deleteChannel(m_channel);
+	}
+
+	//! Runs the stages of AudioEngine::renderNextBuffer() that involve the bus
+	void render(SampleFrame* output)
+	{
+		Engine::mixer()->prepareMasterMix();
+
+		AudioEngineWorkerThread::resetJobQueue();
+		for (const auto& handle : m_handles) { AudioEngineWorkerThread::addJob(handle.get()); }
+		AudioEngineWorkerThread::startAndWaitForJobs();
+
+		AudioEngineWorkerThread::resetJobQueue();
+		for (const auto& port : m_ports) { AudioEngineWorkerThread::addJob(port.get()); }
+		AudioEngineWorkerThread::startAndWaitForJobs();
+
+		Engine::mixer()->masterMix(output);
+	}
+
+private:
+	int m_channel;
+	std::vector<std::unique_ptr<AudioPort>> m_ports;
+	std::vector<std::unique_ptr<ConstantPlayHandle>> m_handles;
+};
+
+} // namespace
+
+class MixerTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase()
+	{
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		Engine::destroy();
+	}
+
+	void ChannelSumsAllPortsTest()
+	{
+		constexpr int NumPorts = 32;
+		Bus bus(NumPorts);
+
+		const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
+		auto output = std::vector<SampleFrame>(fpp);
+		bus.render(output.data());
+
+		// 1/1024 + 2/1024 + ... + 32/1024
+		const float expected = NumPorts * (NumPorts + 1) / 2 / 1024.f;
+		for (const auto& frame : output)
+		{
+			QCOMPARE(frame.left(), expected);
+			QCOMPARE(frame.right(), expected);
+		}
+	}
+
+	void BusBenchmark_data()
+	{
+		QTest::addColumn<int>("numPorts");
+		for (int numPorts : {8, 64, 256})
+		{
+			QTest::newRow(qPrintable(QString("%1 tracks").arg(numPorts))) << numPorts;
+		}
+	}
+
+	void BusBenchmark()
+	{
+		QFETCH(int, numPorts);
+		Bus bus(numPorts);
+
+		auto output = std::vector<SampleFrame>(Engine::audioEngine()->framesPerPeriod());
+		QBENCHMARK
+		{
+			bus.render(output.data());
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(MixerTest)
+#include "MixerTest.moc"
@@ -0,0 +1,236 @@
+/*
+ * SampleCacheTest.cpp
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ConfigManager.h"
+#include "Engine.h"
+#include "SampleCache.h"
+#include "SampleDiskCache.h"
+
+namespace
+{
+
+//! Writes a mono 16 bit wave file of @p frames frames, all set to @p value
+void writeWave(const QString& fileName, int frames, std::int16_t value = 1000)
+{
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+	QDataStream out(&file);
+	out.setByteOrder(QDataStream::LittleEndian);
+
+	const auto dataBytes = static_cast<quint32>(frames * 2);
+	out.writeRawData("RIFF", 4);
+	out << quint32{36 + dataBytes};
+	out.writeRawData("WAVEfmt ", 8);
+	out << quint32{16} << quint16{1} << quint16{1} << quint32{44100} << quint32{44100 * 2}
+		<< quint16{2} << quint16{16};
+	out.writeRawData("data", 4);
+	out << dataBytes;
+	for (int i = 0; i < frames; ++i) { out << value; }
+}
+
+} // namespace
+
+class SampleCacheTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		// keep SampleDiskCache out of the user's cache directory
+		QStandardPaths::setTestModeEnabled(true);
+		Engine::init(true);
+		QVERIFY(m_dir.isValid());
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		SampleCache::clear();
+		QDir(ConfigManager::inst()->cacheDir() + "samples").removeRecursively();
+		Engine::destroy();
+	}
+
+	void init()
+	{
+		lmms::SampleCache::clear();
+	}
+
+	void HitTest()
+	{
+		using namespace lmms;
+		const auto fileName = m_dir.filePath("hit.wav");
+		writeWave(fileName, 100);
+
+		const auto first = SampleCache::get(fileName);
+		QCOMPARE(first->size(), std::size_t{100});
+		QCOMPARE(SampleCache::get(fileName), first);
+	}
+
+	void MissAfterChangeTest()
+	{
+		using namespace lmms;
+		const auto fileName = m_dir.filePath("changed.wav");
+		writeWave(fileName, 100);
+		const auto first = SampleCache::get(fileName);
+
+		writeWave(fileName, 200);
+		const auto second = SampleCache::get(fileName);
+		QVERIFY(second != first);
+		QCOMPARE(second->size(), std::size_t{200});
+
+		// users of the old buffer keep it
+		QCOMPARE(first->size(), std::size_t{100});
+	}
+
+	void EvictionTest()
+	{
+		using namespace lmms;
+		const auto fileName = m_dir.filePath("evicted.wav");
+		writeWave(fileName, 100);
+
+		auto weak = std::weak_ptr<const SampleBuffer>{SampleCache::get(fileName)};
+		// unused buffers are kept within the budget...
+		QVERIFY(!weak.expired());
+
+		// ...and dropped once it is exceeded
+		SampleCache::setByteBudget(0);
+		QVERIFY(weak.expired());
+
+		// buffers still in use are shared even without a budget
+		const auto used = SampleCache::get(fileName);
+		QCOMPARE(SampleCache::get(fileName), used);
+
+		SampleCache::setByteBudget(SampleCache::DefaultByteBudget);
+	}
+
+	void PrefetchTest()
+	{
+		using namespace lmms;
+		const auto fileName = m_dir.filePath("prefetched.wav");
+		writeWave(fileName, 100);
+
+		const auto prefetched = SampleCache::prefetch(fileName).get();
+		QVERIFY(prefetched);
+		QCOMPARE(SampleCache::get(fileName), prefetched);
+
+		// failures are left to the later call to report
+		const auto missing = m_dir.filePath("missing.wav");
+		QVERIFY(!SampleCache::prefetch(missing).get());
+		QVERIFY_EXCEPTION_THROWN(SampleCache::get(missing), std::runtime_error);
+	}
+
+	void DiskCacheTest()
+	{
+		using namespace lmms;
+
+		auto frames = std::vector<SampleFrame>(1000);
+		for (std::size_t i = 0; i < frames.size(); ++i) { frames[i] = SampleFrame{i / 1000.f, -(i / 1000.f)}; }
+
+		const auto key = QByteArray{"0123456789abcdef0123456789abcdef01234567"};
+		QVERIFY(!SampleDiskCache::load(key));
+		SampleDiskCache::store(key, frames, 48000);
+
+		const auto mapping = SampleDiskCache::load(key);
+		QVERIFY(mapping);
+		QCOMPARE(mapping->frames, frames.size());
+		QCOMPARE(mapping->sampleRate, 48000);
+		for (std::size_t i = 0; i < frames.size(); ++i)
+		{
+			QCOMPARE(mapping->data.get()[i].left(), frames[i].left());
+			QCOMPARE(mapping->data.get()[i].right(), frames[i].right());
+		}
+
+		// the mapping is private, writing to it does not change the cached file
+		mapping->data.get()[0] = SampleFrame{1.f, 1.f};
+		QCOMPARE(SampleDiskCache::load(key)->data.get()[0].left(), 0.f);
+	}
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5,10,0))
+	void DiskCacheAccessTest()
+	{
+		using namespace lmms;
+
+		const auto key = QByteArray{"76543210fedcba9876543210fedcba9876543210"};
+		SampleDiskCache::store(key, std::vector<SampleFrame>(100), 44100);
+
+		// entries are evicted by modification time, which a hit has to refresh
+		const auto path = ConfigManager::inst()->cacheDir() + "samples/" + key + ".pcm";
+		const auto past = QDateTime::currentDateTimeUtc().addDays(-30);
+		{
+			QFile file(path);
+			QVERIFY(file.open(QIODevice::ReadOnly));
+			QVERIFY(file.setFileTime(past, QFileDevice::FileModificationTime));
+		}
+		QVERIFY(SampleDiskCache::load(key));
+		QVERIFY(QFileInfo{path}.lastModified().toUTC() > past.addDays(1));
+	}
+#endif
+
+	void DiskCacheKeyTest()
+	{
+		using namespace lmms;
+
+		// uncompressed files are not worth caching
+		const auto wave = m_dir.filePath("uncached.wav");
+		writeWave(wave, 100);
+		QVERIFY(SampleDiskCache::key(wave).isEmpty());
+
+		// other files are keyed by their contents
+		const auto compressed = m_dir.filePath("compressed.ogg");
+		const auto contents = QByteArray{"not really ogg"};
+		{
+			QFile file(compressed);
+			QVERIFY(file.open(QIODevice::WriteOnly));
+			file.write(contents);
+		}
+		QCOMPARE(SampleDiskCache::key(compressed), QCryptographicHash::hash(contents, QCryptographicHash::Sha1).toHex());
+
+		const auto copy = m_dir.filePath("copy.ogg");
+		QVERIFY(QFile::copy(compressed, copy));
+		QCOMPARE(SampleDiskCache::key(copy), SampleDiskCache::key(compressed));
+	}
+
+private:
+	QTemporaryDir m_dir;
+};
+
+QTEST_GUILESS_MAIN(SampleCacheTest)
+#include "SampleCacheTest.moc"
@@ -0,0 +1,112 @@
+/*
+ * SampleStreamTest.cpp
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include <QDataStream>
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AudioEngine.h"
+#include "Engine.h"
+#include "Sample.h"
+#include "SampleBuffer.h"
+#include "SampleStream.h"
+
+class SampleStreamTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		Engine::init(true);
+		QVERIFY(m_dir.isValid());
+
+		// a mono 16 bit wave file just long enough to be streamed, with a different value in every frame
+		m_fileName = m_dir.filePath("long.wav");
+		QFile file(m_fileName);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+
+		const auto frames = static_cast<quint32>(SampleStream::ThresholdBytes / sizeof(SampleFrame) + 100000);
+		QDataStream out(&file);
+		out.setByteOrder(QDataStream::LittleEndian);
+		out.writeRawData("RIFF", 4);
+		out << quint32{36 + frames * 2};
+		out.writeRawData("WAVEfmt ", 8);
+		const auto sampleRate = static_cast<quint32>(Engine::audioEngine()->outputSampleRate());
+		out << quint32{16} << quint16{1} << quint16{1} << sampleRate << sampleRate * 2 << quint16{2} << quint16{16};
+		out.writeRawData("data", 4);
+		out << frames * 2;
+		for (quint32 i = 0; i < frames; ++i) { out << static_cast<std::int16_t>(i * 7919); }
+	}
+
+	void cleanupTestCase()
+	{
+		lmms::Engine::destroy();
+	}
+
+	//! Rendering must not drop frames the I/O thread has not read yet
+	void RenderMatchesDecodeTest()
+	{
+		using namespace lmms;
+
+		const auto streamed = SampleStream::createBuffer(m_fileName);
+		QVERIFY(streamed);
+		QVERIFY(streamed->streamed());
+		const auto decoded = SampleBuffer(m_fileName);
+		QCOMPARE(streamed->size(), decoded.size());
+
+		// played like a sample clip, in periods and as fast as possible
+		const auto sample = Sample(streamed);
+		auto state = Sample::PlaybackState{};
+		const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
+		auto period = std::vector<SampleFrame>(fpp);
+
+		auto mismatches = std::size_t{0};
+		for (std::size_t position = 0; position < decoded.size(); position += fpp)
+		{
+			QVERIFY(sample.play(period.data(), &state, fpp));
+			const auto frames = std::min<std::size_t>(fpp, decoded.size() - position);
+			for (std::size_t i = 0; i < frames; ++i)
+			{
+				const auto& expected = decoded.data()[position + i];
+				if (period[i].left() != expected.left() || period[i].right() != expected.right()) { ++mismatches; }
+			}
+		}
+		QCOMPARE(mismatches, std::size_t{0});
+	}
+
+private:
+	QTemporaryDir m_dir;
+	QString m_fileName;
+};
+
+QTEST_GUILESS_MAIN(SampleStreamTest)
+#include "SampleStreamTest.moc"
@@ -27,6 +27,7 @@
 #include "QCoreApplication"
 
 #include "AutomationClip.h"
+#include "AutomationRoutingTable.h"
 #include "AutomationTrack.h"
 #include "DetuningHelper.h"
 #include "InstrumentTrack.h"
@@ -87,6 +88,54 @@ private slots:
 		QCOMPARE(c.valueAt(150), 1.0f);
 	}
 
+	void testClipCubicHermite()
+	{
+		using namespace lmms;
+
+		AutomationClip c(nullptr);
+		c.setProgressionType(AutomationClip::ProgressionType::CubicHermite);
+		c.putValue(0, 0.0, false);
+		c.putValue(100, 1.0, false);
+
+		QCOMPARE(c.valueAt(0), 0.0f);
+		QCOMPARE(c.valueAt(50), 0.625f);
+		QCOMPARE(c.valueAt(100), 1.0f);
+		QCOMPARE(c.valueAt(150), 1.0f);
+
+		// editing the clip must be visible to the next lookup
+		c.setTension("0");
+		QCOMPARE(c.valueAt(50), 0.5f);
+	}
+
+	void testClipValuesAt()
+	{
+		using namespace lmms;
+
+		AutomationClip c(nullptr);
+		c.setProgressionType(AutomationClip::ProgressionType::CubicHermite);
+		c.putValue(0, 0.0, false);
+		c.putValues(48, 0.8, 0.2, false);
+		c.putValue(96, 0.5, false);
+		c.putValue(192, 1.0, false);
+
+		// batched lookup matches single lookups, also when jumping backwards
+		for (int start : {-10, 0, 40, 150, 5, 300})
+		{
+			float values[64];
+			c.valuesAt(start, 1.f, 64, values);
+			for (int i = 0; i < 64; ++i)
+			{
+				QCOMPARE(values[i], c.valueAt(start + i));
+			}
+		}
+
+		// fractional steps for sample-exact automation
+		float values[4];
+		c.valuesAt(47.5f, 0.25f, 4, values);
+		QCOMPARE(values[2], 0.8f);
+		QVERIFY(std::abs(values[3] - 0.2f) < 0.01f);
+	}
+
 	void testClips()
 	{
 		using namespace lmms;
@@ -123,6 +172,82 @@ private slots:
 		QCOMPARE(song->automatedValuesAt(150)[&model], 0.5f);
 	}
 
+	void testRoutingTable()
+	{
+		using namespace lmms;
+
+		FloatModel model(0, 0, 1, 0.001f);
+
+		auto song = Engine::getSong();
+		AutomationTrack track(song);
+
+		AutomationClip c1(&track);
+		c1.setProgressionType(AutomationClip::ProgressionType::Linear);
+		c1.putValue(0, 0.0, false);
+		c1.putValue(10, 1.0, false);
+		c1.movePosition(0);
+		c1.addObject(&model);
+
+		AutomationClip c2(&track);
+		c2.setProgressionType(AutomationClip::ProgressionType::Linear);
+		c2.putValue(0, 0.0, false);
+		c2.putValue(100, 1.0, false);
+		c2.movePosition(100);
+		c2.addObject(&model);
+
+		AutomationRoutingTable table;
+		table.rebuild(song->tracks(), -1);
+		QVERIFY(table.isValidFor(-1));
+		QVERIFY(!table.isValidFor(0));
+
+		// the table resolves the same values as a full scan of the tracks
+		for (int tick : {0, 5, 10, 50, 100, 150, 250})
+		{
+			table.evaluate(tick);
+			table.apply();
+			QCOMPARE(model.value<float>(), song->automatedValuesAt(tick)[&model]);
+		}
+
+		// arrangement edits invalidate it
+		c2.movePosition(200);
+		QVERIFY(!table.isValidFor(-1));
+	}
+
+	void testRoutingTableAcrossTracks()
+	{
+		using namespace lmms;
+
+		FloatModel model(0, 0, 1, 0.001f);
+
+		auto song = Engine::getSong();
+		AutomationTrack track1(song);
+		AutomationTrack track2(song);
+
+		// the later clip wins, even though it is on the earlier track
+		AutomationClip c1(&track1);
+		c1.setProgressionType(AutomationClip::ProgressionType::Discrete);
+		c1.putValue(0, 1.0, false);
+		c1.movePosition(100);
+		c1.addObject(&model);
+
+		AutomationClip c2(&track2);
+		c2.setProgressionType(AutomationClip::ProgressionType::Discrete);
+		c2.putValue(0, 0.5, false);
+		c2.movePosition(0);
+		c2.addObject(&model);
+
+		AutomationRoutingTable table;
+		table.rebuild(song->tracks(), -1);
+
+		for (int tick : {0, 50, 100, 150})
+		{
+			table.evaluate(tick);
+			table.apply();
+			QCOMPARE(model.value<float>(), song->automatedValuesAt(tick)[&model]);
+		}
+		QCOMPARE(model.value<float>(), 1.0f);
+	}
+
 	void testLengthRespected()
 	{
 		using namespace lmms;
@@ -0,0 +1,212 @@
+/*
+ * MidiClipTest.cpp
+ *
+ * Copyright (c) 2026 LMMS team
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest/QtTest>
+
+#include "QCoreApplication"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "InstrumentTrack.h"
+#include "MidiClip.h"
+
+#include "Engine.h"
+#include "Song.h"
+
+namespace
+{
+
+//! What InstrumentTrack::play() used to do: scan from the first note on every tick
+lmms::MidiClip::NoteRange linearNotesStartingAt(const lmms::NoteVector& notes, const lmms::TimePos& pos)
+{
+	auto first = notes.begin();
+	while (first != notes.end() && (*first)->pos() < pos) { ++first; }
+	auto last = first;
+	while (last != notes.end() && (*last)->pos() == pos) { ++last; }
+	return {first, last};
+}
+
+//! Fills the clip with one note every third tick and a three note chord every 48 ticks
+void fillDenseClip(lmms::MidiClip& clip, int numNotes)
+{
+	using namespace lmms;
+	for (int i = 0; i < numNotes; ++i)
+	{
+		const int pos = i * 3;
+		clip.addNote(Note(TimePos(12), TimePos(pos), 40 + i % 24), false);
+		if (pos % 48 == 0)
+		{
+			clip.addNote(Note(TimePos(12), TimePos(pos), 64), false);
+			clip.addNote(Note(TimePos(12), TimePos(pos), 67), false);
+		}
+	}
+}
+
+//! What Track::getClipsInRange() used to do: scan all clips of the track
+lmms::Track::clipVector linearClipsInRange(const lmms::Track& track, int start, int end)
+{
+	using namespace lmms;
+	auto clips = Track::clipVector{};
+	for (Clip* clip : track.getClips())
+	{
+		if (clip->startPosition() <= end && clip->endPosition() >= start)
+		{
+			clips.insert(std::upper_bound(clips.begin(), clips.end(), clip, Clip::comparePosition), clip);
+		}
+	}
+	return clips;
+}
+
+} // namespace
+
+class MidiClipTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		Engine::destroy();
+	}
+
+	void NotesStartingAtTest()
+	{
+		using namespace lmms;
+
+		InstrumentTrack instrumentTrack(Engine::getSong());
+		MidiClip clip(&instrumentTrack);
+		fillDenseClip(clip, 1000);
+		const int lastTick = clip.notes().back()->pos() + 10;
+
+		// sequential playback, including ticks before the clip starts
+		for (int tick = -10; tick < lastTick; ++tick)
+		{
+			QVERIFY(clip.notesStartingAt(TimePos(tick)) == linearNotesStartingAt(clip.notes(), TimePos(tick)));
+		}
+
+		// jumps backwards and forwards, like looping or moving the play position
+		for (int tick : {0, 2999, 48, 47, 1500, 1500, 1503, 0, lastTick, 96})
+		{
+			QVERIFY(clip.notesStartingAt(TimePos(tick)) == linearNotesStartingAt(clip.notes(), TimePos(tick)));
+		}
+
+		// chords are returned completely
+		const auto [first, last] = clip.notesStartingAt(TimePos(96));
+		QCOMPARE(std::distance(first, last), 3);
+
+		// editing the clip must not leave the cursor pointing at stale notes
+		clip.notesStartingAt(TimePos(2400));
+		clip.clearNotes();
+		fillDenseClip(clip, 10);
+		for (int tick = 0; tick < 40; ++tick)
+		{
+			QVERIFY(clip.notesStartingAt(TimePos(tick)) == linearNotesStartingAt(clip.notes(), TimePos(tick)));
+		}
+	}
+
+	void ClipsInRangeTest()
+	{
+		using namespace lmms;
+
+		InstrumentTrack instrumentTrack(Engine::getSong());
+
+		// a background clip spanning the whole song and many short ones on top of it
+		auto clips = std::vector<std::unique_ptr<MidiClip>>{};
+		clips.push_back(std::make_unique<MidiClip>(&instrumentTrack));
+		clips.back()->changeLength(TimePos(200 * 192));
+		for (int i = 0; i < 200; ++i)
+		{
+			clips.push_back(std::make_unique<MidiClip>(&instrumentTrack));
+			clips.back()->movePosition(TimePos(i * 192 + (i % 3) * 24));
+			clips.back()->changeLength(TimePos(i % 5 == 0 ? 960 : 96));
+		}
+
+		const auto compare = [&instrumentTrack] {
+			const auto ranges = std::vector<std::pair<int, int>>{{-100, -1}, {0, 0}, {100, 120}, {191, 192},
+				{5000, 5100}, {20000, 40000}, {38400, 38400}, {38401, 50000}};
+			for (const auto& [start, end] : ranges)
+			{
+				auto clipsInRange = Track::clipVector{};
+				instrumentTrack.getClipsInRange(clipsInRange, TimePos(start), TimePos(end));
+				if (clipsInRange != linearClipsInRange(instrumentTrack, start, end)) { return false; }
+			}
+			return true;
+		};
+		QVERIFY(compare());
+
+		// moving, resizing and removing clips updates the index
+		clips[10]->movePosition(TimePos(5050));
+		clips[20]->changeLength(TimePos(30000));
+		clips[0].reset();
+		QVERIFY(compare());
+	}
+
+	void NoteLookupBenchmark_data()
+	{
+		QTest::addColumn<bool>("indexed");
+		QTest::addColumn<int>("numNotes");
+		for (int numNotes : {100, 10000})
+		{
+			QTest::newRow(qPrintable(QString("linear scan, %1 notes").arg(numNotes))) << false << numNotes;
+			QTest::newRow(qPrintable(QString("indexed, %1 notes").arg(numNotes))) << true << numNotes;
+		}
+	}
+
+	void NoteLookupBenchmark()
+	{
+		using namespace lmms;
+		QFETCH(bool, indexed);
+		QFETCH(int, numNotes);
+
+		InstrumentTrack instrumentTrack(Engine::getSong());
+		MidiClip clip(&instrumentTrack);
+		fillDenseClip(clip, numNotes);
+		const int lastTick = clip.notes().back()->pos();
+
+		// play the whole clip tick by tick, like InstrumentTrack::play() does
+		std::size_t notesFound = 0;
+		QBENCHMARK
+		{
+			for (int tick = 0; tick <= lastTick; ++tick)
+			{
+				const auto [first, last] = indexed
+					? clip.notesStartingAt(TimePos(tick))
+					: linearNotesStartingAt(clip.notes(), TimePos(tick));
+				notesFound += std::distance(first, last);
+			}
+		}
+		QVERIFY(notesFound > 0);
+	}
+};
+
+QTEST_GUILESS_MAIN(MidiClipTest)
+#include "MidiClipTest.moc"